@@ -0,0 +1,85 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  calib.c (V1.1)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  STM32F100RB
+// IDE       :  Vision V4.60.0.0
+// Compiler  :  Armcc
+// Brief     :  Calibration profiles for the conversion of raw measurement
+//              results into a flow.
+//==============================================================================
+
+//-- Includes ------------------------------------------------------------------
+#include "calib.h"
+
+//-- Global Variables ----------------------------------------------------------
+// Profiles with offset and scale factors from datasheet (SFM3000). To correct
+// non-linearities, add a table with CALIB_TABLE_SIZE entries to a profile.
+static const stCalibProfile profiles[] = {
+  // name     offset  gain               correction
+  { "Air/N2", 32000,  CALIB_GAIN(140.0), NULL },
+  { "O2",     32000,  CALIB_GAIN(142.8), NULL },
+};
+
+#define NBR_OF_PROFILES (sizeof(profiles) / sizeof(profiles[0]))
+
+// selected profile, written with a single (atomic) store
+static const stCalibProfile* volatile activeProfile = &profiles[0];
+
+//==============================================================================
+etError Calib_SelectProfile(u8t index){
+//==============================================================================
+  if(index >= NBR_OF_PROFILES) return PARAMETER_ERROR;
+
+  activeProfile = &profiles[index];
+
+  return NO_ERROR;
+}
+
+//==============================================================================
+u8t Calib_GetNbrOfProfiles(void){
+//==============================================================================
+  return NBR_OF_PROFILES;
+}
+
+//==============================================================================
+const stCalibProfile* Calib_GetProfile(u8t index){
+//==============================================================================
+  if(index >= NBR_OF_PROFILES) return NULL;
+
+  return &profiles[index];
+}
+
+//==============================================================================
+i32t Calib_ConvertFlow(const stCalibProfile *profile, u16t result){
+//==============================================================================
+  const i16t *corr; // table entries around result
+  i32t        frac; // position between entries
+  i32t        flow; // converted flow
+
+  // linear model: (result - offset) * gain / 65536, rounded; one 32x32->64
+  // bit multiply (SMULL on the Cortex-M3) and a shift
+  flow = (i32t)(((i64t)((i32t)result - profile->offset) * profile->gain +
+                 0x8000) >> 16);
+
+  // correction: table lookup by the upper bits, rounded interpolation by the
+  // lower bits
+  if(profile->correction != NULL)
+  {
+    corr  = &profile->correction[result >> CALIB_FRAC_BITS];
+    frac  = result & ((1 << CALIB_FRAC_BITS) - 1);
+    flow += corr[0] + (((corr[1] - corr[0]) * frac +
+                        (1 << (CALIB_FRAC_BITS - 1))) >> CALIB_FRAC_BITS);
+  }
+
+  return flow;
+}
+
+//==============================================================================
+i32t Calib_GetFlow(u16t result){
+//==============================================================================
+  return Calib_ConvertFlow(activeProfile, result); // selection read only once
+}
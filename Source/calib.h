@@ -0,0 +1,94 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  calib.h (V1.1)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  STM32F100RB
+// IDE       :  Vision V4.60.0.0
+// Compiler  :  Armcc
+// Brief     :  Calibration profiles (e.g. per gas) for the conversion of raw
+//              measurement results into a flow, in integer math. A profile
+//              consists of a linear model (offset, scale) and an optional
+//              correction table, which is indexed directly by the upper bits
+//              of the raw result and linearly interpolated.
+//==============================================================================
+
+#ifndef CALIB_H
+#define CALIB_H
+
+//-- Includes ------------------------------------------------------------------
+#include <stddef.h>
+#include "system.h"
+
+//-- Defines -------------------------------------------------------------------
+#define CALIB_FLOW_UNIT   1000 // flow resolution: 1/1000 of the predefined unit
+
+#define CALIB_TABLE_BITS  5    // upper bits of the raw result used as index
+#define CALIB_FRAC_BITS   (16 - CALIB_TABLE_BITS) // bits for interpolation
+#define CALIB_TABLE_SIZE  ((1 << CALIB_TABLE_BITS) + 1) // incl. end point
+
+// Gain of the linear model for a scale factor from the datasheet.
+#define CALIB_GAIN(scale) ((i32t)(65536.0 * CALIB_FLOW_UNIT / (scale) + 0.5))
+
+//-- Type definitions ----------------------------------------------------------
+// Calibration profile.
+typedef struct{
+  const char *name;       // profile name, e.g. "Air"
+  u16t        offset;     // offset flow (raw measurement units)
+  i32t        gain;       // CALIB_GAIN(scale factor flow)
+  const i16t *correction; // CALIB_TABLE_SIZE corrections [1/CALIB_FLOW_UNIT]
+                          // at the raw results i << CALIB_FRAC_BITS, or NULL
+}stCalibProfile;
+
+//==============================================================================
+etError Calib_SelectProfile(u8t index);
+//==============================================================================
+// Selects the profile used by Calib_GetFlow. The selection takes effect with
+// the next conversion and may also be changed from an interrupt.
+//------------------------------------------------------------------------------
+// input:  index        index of the profile
+//
+// return: error:       PARAMETER_ERROR = no profile with this index
+//                      NO_ERROR        = no error
+
+//==============================================================================
+u8t Calib_GetNbrOfProfiles(void);
+//==============================================================================
+// Gets the number of available profiles.
+//------------------------------------------------------------------------------
+
+//==============================================================================
+const stCalibProfile* Calib_GetProfile(u8t index);
+//==============================================================================
+// Gets a profile, e.g. to show its name.
+//------------------------------------------------------------------------------
+// input:  index        index of the profile
+//
+// return: pointer to the profile, NULL if there is no profile with this index
+
+//==============================================================================
+i32t Calib_ConvertFlow(const stCalibProfile *profile, u16t result);
+//==============================================================================
+// Converts a raw measurement result with a given profile.
+//------------------------------------------------------------------------------
+// input:  *profile     calibration profile
+//         result       raw measurement result
+//
+// return: flow in 1/CALIB_FLOW_UNIT of the predefined unit
+//
+// remark: flow = (result - offset) / scale + correction(result), both terms
+//         rounded to the flow resolution
+
+//==============================================================================
+i32t Calib_GetFlow(u16t result);
+//==============================================================================
+// Converts a raw measurement result with the selected profile.
+//------------------------------------------------------------------------------
+// input:  result       raw measurement result
+//
+// return: flow in 1/CALIB_FLOW_UNIT of the predefined unit (see
+//         Calib_ConvertFlow)
+
+#endif
@@ -2,9 +2,9 @@
 //    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
 //==============================================================================
 // Project   :  SF05 Sample Code (V1.1)
-// File      :  main.c (V1.1)
+// File      :  main.c (V1.4)
 // Author    :  RFU
-// Date      :  26-Jul-2015
+// Date      :  19-Oct-2026
 // Controller:  STM32F100RB
 // IDE       :  Vision V4.60.0.0
 // Compiler  :  Armcc
@@ -20,17 +20,50 @@
 //   - change the port functions / definitions for your uC    in i2c_hal.h/.c
 //   - adapt the timing of the delay function for your uC     in system.c
 //   - adapt the SystemInit()                                 in system.c
+//   - adapt the microsecond timer (TIM2)                     in system.c
+//   - adapt the USART / DMA of the sample stream             in stream.c
 //   - change the uC register definition file <stm32f10x.h>   in system.h
 //==============================================================================
 
 //-- Includes ------------------------------------------------------------------
 #include "system.h"
 #include "sf05.h"
+#include "calib.h"
+#include "stats.h"
+#include "stream.h"
 
 //-- Defines -------------------------------------------------------------------
-// Offset and scale factors from datasheet (SFM3000).
-#define OFFSET_FLOW 32000.0F   // offset flow
-#define SCALE_FLOW    140.0F   // scale factor flow
+// Sample period, kept by the timer independent of the read duration.
+#define SAMPLE_PERIOD   (TIMER_TICKS_PER_SECOND / 10) // 100ms
+
+// Calibration profile (see calib.c), can be changed while sampling.
+#define CALIB_PROFILE   0      // Air/N2
+
+// Conversion benchmark at start-up: 1 = the cycles of the integer conversion
+// (Calib_GetFlow) and of the float conversion (SF05_CalcFlow, soft-float) are
+// counted with the DWT cycle counter, see cyclesInteger and cyclesFloat.
+#define BENCHMARK       0
+#define BENCHMARK_LOOPS 1000   // conversions per path
+#define BENCHMARK_SCALE 140.0F // scale factor flow Air/N2 (float path)
+
+// User button: the level is taken once it has been stable for this time after
+// the last edge. Presses and releases are assumed to be longer.
+#define BUTTON_DEBOUNCE (TIMER_TICKS_PER_SECOND / 50) // 20ms
+
+// Flow statistics: 95th percentile over windows of one minute (600 x 100ms).
+#define STATS_QUANTILE  0.95F  // estimated quantile
+#define STATS_WINDOW    600    // samples per window
+
+//-- Global Variables ----------------------------------------------------------
+stStatistics  flowStats;           // flow statistics (raw measurement units)
+volatile u8t  resetRequest = 0;    // soft reset requested by the user button
+static u8t    buttonPressed = 0;   // debounced state of the user button
+static volatile u8t  buttonBouncing = 0; // edge seen, level not yet taken
+static volatile u64t buttonEdge     = 0; // time of the last edge [ticks]
+#if BENCHMARK
+u32t          cyclesInteger = 0;   // cycles per integer conversion
+u32t          cyclesFloat   = 0;   // cycles per float conversion
+#endif
 
 //==============================================================================
 void Led_Init(void){
@@ -47,6 +80,50 @@ void UserButton_Init(void){
   RCC->APB2ENR |= 0x00000004;  // I/O port A clock enabled
   GPIOA->CRH   &= 0xFFFFFFF0;  // set general purpose input mode for User Button
   GPIOA->CRH   |= 0x00000004;  //
+  
+  RCC->APB2ENR |= 0x00000001;  // alternate function I/O clock enabled
+  AFIO->EXTICR[0] &= 0xFFF0;   // EXTI0 on port A, bit 0 (User Button)
+  EXTI->RTSR   |= 0x00000001;  // interrupt on rising (button pressed) and
+  EXTI->FTSR   |= 0x00000001;  // falling edge (button released)
+  EXTI->IMR    |= 0x00000001;  //
+  buttonPressed = (u8t)(GPIOA->IDR & 0x00000001); // e.g. held during start
+  NVIC_EnableIRQ(EXTI0_IRQn);
+}
+
+//==============================================================================
+void EXTI0_IRQHandler(void){
+//==============================================================================
+  u64t now = Timer_GetTicks(); // time of the edge
+
+  EXTI->PR = 0x00000001;       // clear pending flag
+
+  // every edge restarts the debounce time, the level is taken by
+  // UserButton_Poll when it has been stable
+  buttonEdge     = now;
+  buttonBouncing = 1;
+}
+
+//==============================================================================
+void UserButton_Poll(void){
+//==============================================================================
+  u64t edge;     // time of the last edge
+  u8t  bouncing; // edge seen, level not yet taken
+  u8t  pressed;  // level of the button
+
+  __disable_irq();
+  edge     = buttonEdge;
+  bouncing = buttonBouncing;
+  __enable_irq();
+
+  if(!bouncing || Timer_GetTicks() - edge < BUTTON_DEBOUNCE) return;
+
+  // the pin level is taken, so a missed edge cannot invert the state
+  __disable_irq();
+  if(buttonEdge == edge) buttonBouncing = 0;
+  __enable_irq();
+  pressed = (u8t)(GPIOA->IDR & 0x00000001);
+  if(pressed && !buttonPressed) resetRequest = 1; // between two samples
+  buttonPressed = pressed;
 }
 
 //==============================================================================
@@ -73,60 +150,131 @@ void LedGreenOff(void){
   GPIOC->BSRR = 0x02000000;
 }
 
+#if BENCHMARK
 //==============================================================================
-u8t ReadUserButton(void){
+void Benchmark_Conversion(void){
 //==============================================================================
-  return (GPIOA->IDR & 0x00000001);
+  const stCalibProfile *profile = Calib_GetProfile(CALIB_PROFILE);
+  volatile i32t         flowInt;   // results, kept by the volatile stores
+  volatile ft           flowFloat; //
+  u32t                  start;     // cycle counter at the start of a loop
+  u32t                  empty;     // cycles of the loop without conversion
+  u32t                  i;         // loop counter
+
+  CoreDebug->DEMCR |= 0x01000000;  // trace enabled (needed for the DWT)
+  DWT->CYCCNT       = 0;
+  DWT->CTRL        |= 0x00000001;  // cycle counter enabled
+
+  // the raw results are spread over the whole range
+  start = DWT->CYCCNT;
+  for(i = 0; i < BENCHMARK_LOOPS; i++) flowInt = (i32t)(u16t)(i * 65u);
+  empty = DWT->CYCCNT - start;
+
+  start = DWT->CYCCNT;
+  for(i = 0; i < BENCHMARK_LOOPS; i++)
+    flowInt = Calib_GetFlow((u16t)(i * 65u));
+  cyclesInteger = (DWT->CYCCNT - start - empty) / BENCHMARK_LOOPS;
+
+  start = DWT->CYCCNT;
+  for(i = 0; i < BENCHMARK_LOOPS; i++)
+    flowFloat = SF05_CalcFlow((u16t)(i * 65u), (ft)profile->offset,
+                              BENCHMARK_SCALE);
+  cyclesFloat = (DWT->CYCCNT - start - empty) / BENCHMARK_LOOPS;
+  (void)flowInt;
+  (void)flowFloat;
 }
+#endif
 
 //==============================================================================
 int main(void){
 //==============================================================================
-  etError  error;        // error code
-  u32t     serialNumber; // sensor serial number
-  ft       flow;         // measured flow value
+  etError  error;             // error code
+  u32t     serialNumber;      // sensor serial number
+  u16t     result;            // raw flow measurement result
+  u64t     timestamp = 0;     // time of the measurement result [ticks]
+  u64t     lastTimestamp = 0; // time of the previous measurement result
+  u64t     nextSample;        // start time of the next sample period
+  u8t      gapPending = 0;    // reset gap not yet reported
+  i32t     flow = 0;          // measured flow value [1/CALIB_FLOW_UNIT]
 
   SystemInit();
+  Timer_Init();
   Led_Init();
   UserButton_Init();
   SF05_Init();
+  Calib_SelectProfile(CALIB_PROFILE);
+#if BENCHMARK
+  Benchmark_Conversion();
+#endif
+  Stats_Init(&flowStats, STATS_QUANTILE, STATS_WINDOW);
+  Stream_Init();
   
   // read serial number from sensor
   error = SF05_GetSerialNumber(&serialNumber);
+  
+  nextSample = Timer_GetTicks();
 
   while(1)
   {
     error = NO_ERROR;
     
-    if(ReadUserButton() == 0)
-    // if the user button is not pressed
-    { 
-      // read flow from sensor
-      error = SF05_GetFlow(OFFSET_FLOW, SCALE_FLOW, &flow);
+    // if a reset was requested by the user button, reset the sensor and
+    // restart the measurement right away
+    if(resetRequest)
+    {
+      resetRequest = 0;
       
-      // the blue LED lights if a weak flow is detected
-      if(flow > 1.0) LedBlueOn();
-      else           LedBlueOff();
-    }
-    else
-    // if the user button is pressed
-    { 
       // green and blue LED off
       LedGreenOff();
       LedBlueOff();
       
-      // perform a soft reset on the sensor
-      error = SF05_SoftReset();
+      // perform a soft reset on the sensor and resume the flow measurement,
+      // there is no gap before the first sample
+      error = SF05_SoftResetAndResume();
+      gapPending = (lastTimestamp != 0);
+    }
+    
+    // read flow from sensor
+    if(error == NO_ERROR)
+    {
+      error     = SF05_GetFlowResult(&result);
+      timestamp = Timer_GetTicks();
+    }
+    
+    // if no error, compute the flow, update the statistics and stream the
+    // raw result and each complete statistics window to the host (a dropped
+    // sample is not a sensor error)
+    if(error == NO_ERROR)
+    {
+      flow = Calib_GetFlow(result);
+      Stream_AddSample(timestamp, result);
+      if(Stats_Update(&flowStats, result))
+        Stream_AddStatistics(timestamp, &flowStats);
       
-      // wait until button is released
-      while(ReadUserButton() != 0);
+      // report the sample gap caused by the reset to the host
+      if(gapPending)
+      {
+        Stream_AddResetGap(timestamp, (u32t)(timestamp - lastTimestamp));
+        gapPending = 0;
+      }
+      lastTimestamp = timestamp;
     }
     
+    // the blue LED lights if a weak flow is detected
+    if(flow > 1 * CALIB_FLOW_UNIT) LedBlueOn();
+    else                           LedBlueOff();
+    
     // the green LED lights if no error occurs
     if(!error)     LedGreenOn();
     else           LedGreenOff();
     
-    // wait 100ms
-    DelayMicroSeconds(100000);
+    // wait for the next sample period, restart the schedule if it is late by
+    // more than one period (e.g. after a reset); the user button is
+    // debounced meanwhile
+    nextSample += SAMPLE_PERIOD;
+    if((i64t)(Timer_GetTicks() - nextSample) > SAMPLE_PERIOD)
+      nextSample = Timer_GetTicks();
+    while((i64t)(Timer_GetTicks() - nextSample) < 0)
+      UserButton_Poll();
   }
 }
@@ -2,9 +2,9 @@
 //    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
 //==============================================================================
 // Project   :  SF05 Sample Code (V1.1)
-// File      :  sf05.c (V1.2)
+// File      :  sf05.c (V1.4)
 // Author    :  RFU
-// Date      :  20-Aug-2015
+// Date      :  19-Oct-2026
 // Controller:  STM32F100RB
 // IDE       :  Vision V4.60.0.0
 // Compiler  :  Armcc
@@ -15,8 +15,22 @@
 #include "sf05.h"
 #include "i2c_hal.h"
 
+//-- Defines -------------------------------------------------------------------
+#define WARMUP_DISCARDS     1 // results discarded after starting the flow
+                              // measurement (first result may be invalid)
+#define SOFT_RESET_TIME 80000 // time until the sensor has rebooted after a
+                              // soft reset (datasheet) [us]
+#define RESTART_RETRIES    20 // further command retries (approx. 1ms each)
+                              // if the sensor is not yet ready
+#define READ_DELAY      10000 // wait between two read retries [us]
+#define FAST_READ_DELAY   100 // wait between two read retries right after
+                              // starting the measurement, which takes
+                              // approx. 0.5ms [us]
+#define FAST_READ_RETRIES 100 // read retries right after starting
+
 //-- Global Variables ----------------------------------------------------------
-u16t currentCommand = 0x0000;
+u16t        currentCommand = 0x0000;
+static u8t  warmUpDiscards = 0; // results still to be discarded
 
 //==============================================================================
 void SF05_Init(void){
@@ -69,9 +83,10 @@ etError SF05_ReadCommandResult(u16t *result){
 }
 
 //==============================================================================
-etError SF05_ReadCommandResultWithTimeout(u8t maxRetries, u16t *result){
+static etError SF05_PollCommandResult(u8t maxRetries, u32t delay,
+                                      u16t *result){
 //==============================================================================
-  etError error; //variable for error code
+  etError error = ACK_ERROR; // error code
   
   while(maxRetries--)
   {
@@ -83,29 +98,87 @@ etError SF05_ReadCommandResultWithTimeout(u8t maxRetries, u16t *result){
     if(error == NO_ERROR) break;
     
     // if it was not successful -> wait a short time and then try it again
-    DelayMicroSeconds(10000);
+    DelayMicroSeconds(delay);
   }
+  
+  // if the sensor did not answer in time, the command may have been lost
+  // (e.g. by a reboot) -> it is written again with the next measurement
+  if(error != NO_ERROR)
+    currentCommand = 0x0000;
 
   return error;
 }
+
+//==============================================================================
+etError SF05_ReadCommandResultWithTimeout(u8t maxRetries, u16t *result){
+//==============================================================================
+  return SF05_PollCommandResult(maxRetries, READ_DELAY, result);
+}
  
 //==============================================================================
-etError SF05_GetFlow(ft offset, ft scale, ft *flow){
+static etError SF05_StartFlowMeasurement(u8t maxRetries){
+//==============================================================================
+  etError error = ACK_ERROR; // error code
+  
+  while(maxRetries--)
+  {
+    // try to write the command, the sensor does not acknowledge while booting
+    error = SF05_WriteCommand(FLOW_MEASUREMENT);
+    if(error == NO_ERROR) break;
+    
+    // if it was not successful -> wait a short time and then try it again
+    DelayMicroSeconds(1000);
+  }
+  
+  // if no error, the first results have to be discarded
+  if(error == NO_ERROR)
+    warmUpDiscards = WARMUP_DISCARDS;
+  
+  return error;
+}
+
+//==============================================================================
+etError SF05_GetFlowResult(u16t *result){
 //==============================================================================
   etError error = NO_ERROR; // error code
-  u16t    result;           // read result from sensor
+  u8t     started;          // measurement just started -> poll fast
   
   // write command if it is not already set 
   if(currentCommand != FLOW_MEASUREMENT)
-    error = SF05_WriteCommand(FLOW_MEASUREMENT);
+    error = SF05_StartFlowMeasurement(1);
+  started = (warmUpDiscards > 0);
   
-  // if no error, read command result
-  if(error == NO_ERROR)
-    error = SF05_ReadCommandResultWithTimeout(20, &result);
+  // discard the results after starting the measurement
+  while(error == NO_ERROR && warmUpDiscards > 0)
+  {
+    error = SF05_PollCommandResult(FAST_READ_RETRIES, FAST_READ_DELAY,
+                                   result);
+    if(error == NO_ERROR) warmUpDiscards--;
+  }
+  
+  // if no error, read command result; right after the start, the result is
+  // polled with a short wait to keep the gap small
+  if(error == NO_ERROR && started)
+    error = SF05_PollCommandResult(FAST_READ_RETRIES, FAST_READ_DELAY,
+                                   result);
+  else if(error == NO_ERROR)
+    error = SF05_ReadCommandResultWithTimeout(20, result);
+  
+  return error;
+}
+
+//==============================================================================
+etError SF05_GetFlow(ft offset, ft scale, ft *flow){
+//==============================================================================
+  etError error;  // error code
+  u16t    result; // read result from sensor
+  
+  // read raw measurement result
+  error = SF05_GetFlowResult(&result);
 
   // if no error, compute the flow
   if(error == NO_ERROR)
-    *flow = ((ft)result - offset) / scale;
+    *flow = SF05_CalcFlow(result, offset, scale);
   
   return error;
 }
@@ -153,25 +226,20 @@ etError SF05_SoftReset(void){
 }
 
 //==============================================================================
-etError SF05_CheckCrc(u8t data[], u8t nbrOfBytes, u8t checksum){
+etError SF05_SoftResetAndResume(void){
 //==============================================================================
-  u8t bit;     // bit mask
-  u8t crc = 0; // calculated checksum
-  u8t byteCtr; // byte counter
+  etError error; // error code
+  
+  error = SF05_SoftReset();
   
-  // calculates 8-Bit checksum with given polynomial
-  for(byteCtr = 0; byteCtr < nbrOfBytes; byteCtr++)
+  // the sensor may acknowledge a command before it actually reboots, which
+  // would lose it -> wait until the reboot is over, then restart the flow
+  // measurement as soon as the sensor is ready
+  if(error == NO_ERROR)
   {
-    crc ^= (data[byteCtr]);
-    for(bit = 8; bit > 0; --bit)
-    {
-      if(crc & 0x80) crc = (crc << 1) ^ POLYNOMIAL;
-      else           crc = (crc << 1);
-    }
+    DelayMicroSeconds(SOFT_RESET_TIME);
+    error = SF05_StartFlowMeasurement(RESTART_RETRIES);
   }
   
-  // verify checksum
-  if(crc != checksum) return CHECKSUM_ERROR;
-  else                return NO_ERROR;
+  return error;
 }
-
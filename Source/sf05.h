@@ -2,9 +2,9 @@
 //    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
 //==============================================================================
 // Project   :  SF05 Sample Code (V1.1)
-// File      :  sf05.h (V1.2)
+// File      :  sf05.h (V1.4)
 // Author    :  RFU
-// Date      :  20-Aug-2015
+// Date      :  19-Oct-2026
 // Controller:  STM32F100RB
 // IDE       :  Vision V4.60.0.0
 // Compiler  :  Armcc
@@ -74,7 +74,23 @@ etError SF05_ReadCommandResultWithTimeout(u8t maxRetries, u16t *result);
 // remark: This function is usefull for reading measurement results. If not yet
 //         a new valid measurement was performed, an acknowledge error occurs
 //         and the read will be automatical repeated until a valid measurement
-//         could be read.
+//         could be read. If no result could be read, the current command is
+//         cleared, so that SF05_GetFlowResult writes it again.
+
+//==============================================================================
+etError SF05_GetFlowResult(u16t *result);
+//==============================================================================
+// Gets the raw flow measurement result from the sensor. The "flow measurement"
+// command will be automatical written to the sensor, if it is not already set.
+//------------------------------------------------------------------------------
+// input:  *result        pointer to an integer where the result will be stored
+// 
+// return: errror:        ACK_ERROR      = no acknowledgment from sensor
+//                        CHECKSUM_ERROR = checksum mismatch
+//                        NO_ERROR       = no error
+//
+// remark: The first result after writing the command is discarded, because it
+//         may not be valid.
 
 //==============================================================================
 etError SF05_GetFlow(ft offset, ft scale, ft *flow);
@@ -114,6 +130,30 @@ etError SF05_SoftReset(void);
 // return: error:         ACK_ERROR      = no acknowledgment from sensor
 //                        NO_ERROR       = no error
 
+//==============================================================================
+etError SF05_SoftResetAndResume(void);
+//==============================================================================
+// Forces a sensor reset, waits until the sensor has rebooted and restarts the
+// flow measurement as soon as the sensor acknowledges again, so that the next
+// call of SF05_GetFlowResult does not have to write the command. The next
+// results are polled with a short wait to keep the sample gap small.
+//------------------------------------------------------------------------------
+// return: error:         ACK_ERROR      = no acknowledgment from sensor
+//                        NO_ERROR       = no error
+//
+// remark: The first result after the restart is discarded by
+//         SF05_GetFlowResult.
+
+//==============================================================================
+u8t SF05_CalcCrc(u8t data[], u8t nbrOfBytes);
+//==============================================================================
+// Calculates the 8-bit checksum for n bytes of data.
+//------------------------------------------------------------------------------
+// input:  data[]         checksum is built based on this data
+//         nbrOfBytes     checksum is built for n bytes of data
+//  
+// return: crc:           calculated checksum
+
 //==============================================================================
 etError SF05_CheckCrc(u8t data[], u8t nbrOfBytes, u8t checksum);
 //==============================================================================
@@ -127,4 +167,15 @@ etError SF05_CheckCrc(u8t data[], u8t nbrOfBytes, u8t checksum);
 // return: error:         CHECKSUM_ERROR = checksum does not match
 //                        NO_ERROR       = checksum matches
 
+//==============================================================================
+ft SF05_CalcFlow(u16t result, ft offset, ft scale);
+//==============================================================================
+// Converts a raw measurement result into a flow in a predefined unit.
+//------------------------------------------------------------------------------
+// input:  result         raw measurement result from the sensor
+//         offset         offset flow
+//         scale          scale factor flow
+//
+// return: flow in predefined unit = (result - offset) / scale
+
 #endif
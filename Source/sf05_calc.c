@@ -0,0 +1,53 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  sf05_calc.c (V1.0)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  STM32F100RB
+// IDE       :  Vision V4.60.0.0
+// Compiler  :  Armcc
+// Brief     :  Sensor Layer: Hardware independent calculations (checksum,
+//                            conversion). This file does not access the
+//                            controller and is also built into the host tools
+//                            (see Tools/).
+//==============================================================================
+
+//-- Includes ------------------------------------------------------------------
+#include "sf05.h"
+
+//==============================================================================
+u8t SF05_CalcCrc(u8t data[], u8t nbrOfBytes){
+//==============================================================================
+  u8t bit;     // bit mask
+  u8t crc = 0; // calculated checksum
+  u8t byteCtr; // byte counter
+
+  // calculates 8-Bit checksum with given polynomial
+  for(byteCtr = 0; byteCtr < nbrOfBytes; byteCtr++)
+  {
+    crc ^= (data[byteCtr]);
+    for(bit = 8; bit > 0; --bit)
+    {
+      if(crc & 0x80) crc = (crc << 1) ^ POLYNOMIAL;
+      else           crc = (crc << 1);
+    }
+  }
+
+  return crc;
+}
+
+//==============================================================================
+etError SF05_CheckCrc(u8t data[], u8t nbrOfBytes, u8t checksum){
+//==============================================================================
+  // verify checksum
+  if(SF05_CalcCrc(data, nbrOfBytes) != checksum) return CHECKSUM_ERROR;
+  else                                            return NO_ERROR;
+}
+
+//==============================================================================
+ft SF05_CalcFlow(u16t result, ft offset, ft scale){
+//==============================================================================
+  return ((ft)result - offset) / scale;
+}
@@ -0,0 +1,192 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  stats.c (V1.1)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  STM32F100RB
+// IDE       :  Vision V4.60.0.0
+// Compiler  :  Armcc
+// Brief     :  Online statistics over windows of raw measurement results.
+//==============================================================================
+
+//-- Includes ------------------------------------------------------------------
+#include "stats.h"
+
+//==============================================================================
+etError Stats_Init(stStatistics *stats, ft p, u32t windowSize){
+//==============================================================================
+  if(p < 0.0F || p > 1.0F || windowSize == 0 || windowSize > STATS_MAX_WINDOW)
+    return PARAMETER_ERROR;
+
+  stats->windowSize = windowSize;
+  stats->p          = p;
+  Stats_Reset(stats);
+
+  return NO_ERROR;
+}
+
+//==============================================================================
+void Stats_Reset(stStatistics *stats){
+//==============================================================================
+  stats->count    = 0;
+  stats->min      = 0xFFFF;
+  stats->max      = 0x0000;
+  stats->shift    = 0;
+  stats->reserved = 0;
+  stats->sum      = 0;
+  stats->sumSq    = 0;
+}
+
+//==============================================================================
+static void Stats_UpdateQuantile(stStatistics *stats, ft x){
+//==============================================================================
+  ft   np[5];  // desired marker positions
+  ft   d;      // deviation of a marker from its desired position
+  ft   qp;     // parabolic prediction of a marker height
+  ft   k5;     // samples after the first five
+  i32t ds;     // marker adjustment (+1 or -1)
+  i32t i, k;   // marker indices
+  ft   p = stats->p;
+
+  // the first five samples are kept sorted in the marker heights
+  if(stats->count <= 5)
+  {
+    for(i = (i32t)stats->count - 1; i > 0 && stats->q[i - 1] > x; i--)
+      stats->q[i] = stats->q[i - 1];
+    stats->q[i] = x;
+
+    if(stats->count == 5)
+      for(i = 0; i < 5; i++) stats->n[i] = i;
+    return;
+  }
+
+  // desired positions of the middle markers, computed from the sample count
+  // instead of being accumulated, so that no rounding error builds up
+  k5    = (ft)(stats->count - 5);
+  np[1] = 2.0F * p + k5 * p / 2.0F;
+  np[2] = 4.0F * p + k5 * p;
+  np[3] = 2.0F + 2.0F * p + k5 * (1.0F + p) / 2.0F;
+
+  // find cell k with q[k] <= x < q[k+1], extend the extreme markers
+  if(x < stats->q[0])
+  {
+    stats->q[0] = x;
+    k = 0;
+  }
+  else if(x >= stats->q[4])
+  {
+    stats->q[4] = x;
+    k = 3;
+  }
+  else
+  {
+    for(k = 0; k < 3 && x >= stats->q[k + 1]; k++);
+  }
+
+  // increment positions of markers above k
+  for(i = k + 1; i < 5; i++) stats->n[i]++;
+
+  // adjust heights of the middle markers if necessary
+  for(i = 1; i < 4; i++)
+  {
+    d = np[i] - (ft)stats->n[i];
+    if((d >=  1.0F && stats->n[i + 1] - stats->n[i] >  1) ||
+       (d <= -1.0F && stats->n[i - 1] - stats->n[i] < -1))
+    {
+      ds = (d >= 0.0F) ? 1 : -1;
+
+      // piecewise parabolic prediction
+      qp = stats->q[i] + (ft)ds / (ft)(stats->n[i + 1] - stats->n[i - 1]) *
+           ((ft)(stats->n[i] - stats->n[i - 1] + ds) *
+            (stats->q[i + 1] - stats->q[i]) /
+            (ft)(stats->n[i + 1] - stats->n[i]) +
+            (ft)(stats->n[i + 1] - stats->n[i] - ds) *
+            (stats->q[i] - stats->q[i - 1]) /
+            (ft)(stats->n[i] - stats->n[i - 1]));
+
+      // use linear prediction if the parabolic one breaks the ordering
+      if(stats->q[i - 1] < qp && qp < stats->q[i + 1])
+        stats->q[i] = qp;
+      else
+        stats->q[i] += (ft)ds * (stats->q[i + ds] - stats->q[i]) /
+                       (ft)(stats->n[i + ds] - stats->n[i]);
+
+      stats->n[i] += ds;
+    }
+  }
+}
+
+//==============================================================================
+u8t Stats_Update(stStatistics *stats, u16t result){
+//==============================================================================
+  i32t x; // result relative to the shift
+
+  // start a new window after a complete one
+  if(stats->count >= stats->windowSize)
+    Stats_Reset(stats);
+
+  if(stats->count == 0) stats->shift = result;
+  stats->count++;
+
+  // min/max
+  if(result < stats->min) stats->min = result;
+  if(result > stats->max) stats->max = result;
+
+  // exact sums of the shifted results; x^2 < 2^32, so the unsigned product
+  // is exact also where the signed one would overflow
+  x             = (i32t)result - (i32t)stats->shift;
+  stats->sum   += x;
+  stats->sumSq += (u32t)x * (u32t)x;
+
+  // quantile estimation
+  Stats_UpdateQuantile(stats, (ft)result);
+
+  return (stats->count >= stats->windowSize);
+}
+
+//==============================================================================
+ft Stats_GetMean(const stStatistics *stats){
+//==============================================================================
+  i64t quot; // integer part of the shifted mean
+
+  if(stats->count == 0) return 0.0F;
+
+  quot = stats->sum / (i64t)stats->count;
+  return (ft)((i32t)stats->shift + (i32t)quot) +
+         (ft)(stats->sum - quot * (i64t)stats->count) / (ft)stats->count;
+}
+
+//==============================================================================
+ft Stats_GetVariance(const stStatistics *stats){
+//==============================================================================
+  i64t quot; // integer part of the shifted mean
+  i64t rem;  // remainder of the sum
+  u64t sq;   // sum of squares around the integer part of the mean
+  ft   r;
+
+  if(stats->count < 2) return 0.0F;
+
+  // sum of (x - quot)^2 = sumSq - quot * (sum + rem), exact in 64 bits
+  // (modulo 2^64, the true value is non-negative and fits)
+  quot = stats->sum / (i64t)stats->count;
+  rem  = stats->sum - quot * (i64t)stats->count;
+  sq   = stats->sumSq - (u64t)quot * (u64t)(stats->sum + rem);
+
+  // subtract the remaining part of the mean (|rem| < count)
+  r = (ft)rem;
+  return ((ft)sq - r * r / (ft)stats->count) / (ft)(stats->count - 1);
+}
+
+//==============================================================================
+ft Stats_GetQuantile(const stStatistics *stats){
+//==============================================================================
+  if(stats->count == 0) return 0.0F;
+
+  // exact quantile of the sorted samples while there are less than six
+  if(stats->count <= 5)
+    return stats->q[(u8t)(stats->p * (ft)(stats->count - 1) + 0.5F)];
+
+  return stats->q[2];
+}
@@ -0,0 +1,111 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  stats.h (V1.1)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  STM32F100RB
+// IDE       :  Vision V4.60.0.0
+// Compiler  :  Armcc
+// Brief     :  Online statistics over windows of raw measurement results:
+//              min/max, mean/variance and one quantile (P algorithm by Jain
+//              and Chlamtac). No sample is stored, the update cost per sample
+//              is constant and no memory is allocated. Mean and variance are
+//              accumulated exactly in integers (sums of the results shifted by
+//              the first result of the window), which is also cheaper than
+//              Welford's float updates on a controller without FPU.
+//==============================================================================
+
+#ifndef STATS_H
+#define STATS_H
+
+//-- Includes ------------------------------------------------------------------
+#include "system.h"
+
+//-- Defines -------------------------------------------------------------------
+// Largest window. The P marker positions are compared in float, which
+// resolves them to 1/8 sample up to this size.
+#define STATS_MAX_WINDOW  0x100000
+
+//-- Type definitions ----------------------------------------------------------
+// Statistics state (80 bytes on the STM32F100RB). All values are in raw
+// measurement units, use (value - offset) / scale to convert means and
+// quantiles, and divide the variance by scale^2.
+typedef struct{
+  u32t windowSize; // number of samples per window
+  u32t count;      // number of samples in the current window
+  u16t min;        // smallest result in the current window
+  u16t max;        // largest result in the current window
+  u16t shift;      // first result of the window, subtracted from all results
+  u16t reserved;   // padding
+  i64t sum;        // sum of (result - shift)
+  u64t sumSq;      // sum of (result - shift)^2
+  ft   p;          // quantile to be estimated (0..1)
+  ft   q[5];       // P marker heights
+  i32t n[5];       // P actual marker positions
+}stStatistics;
+
+//==============================================================================
+etError Stats_Init(stStatistics *stats, ft p, u32t windowSize);
+//==============================================================================
+// Initializes the statistics state.
+//------------------------------------------------------------------------------
+// input:  *stats       pointer to the statistics state
+//         p            quantile to be estimated, e.g. 0.95 for the 95th
+//                      percentile
+//         windowSize   number of samples per window (1..STATS_MAX_WINDOW)
+//
+// return: error:       PARAMETER_ERROR = p or window size out of range
+//                      NO_ERROR        = no error
+
+//==============================================================================
+void Stats_Reset(stStatistics *stats);
+//==============================================================================
+// Discards all samples and starts a new window.
+//------------------------------------------------------------------------------
+// input:  *stats       pointer to the statistics state
+
+//==============================================================================
+u8t Stats_Update(stStatistics *stats, u16t result);
+//==============================================================================
+// Adds a raw measurement result to the statistics.
+//------------------------------------------------------------------------------
+// input:  *stats       pointer to the statistics state
+//         result       raw measurement result (see SF05_GetFlowResult)
+//
+// return: 1 = the window is complete with this sample, 0 = otherwise
+//
+// remark: The results of a complete window stay available until the next
+//         update, which starts a new window.
+
+//==============================================================================
+ft Stats_GetMean(const stStatistics *stats);
+//==============================================================================
+// Gets the mean of the current window.
+//------------------------------------------------------------------------------
+// input:  *stats       pointer to the statistics state
+//
+// return: mean in raw measurement units (0 if the window is empty)
+
+//==============================================================================
+ft Stats_GetVariance(const stStatistics *stats);
+//==============================================================================
+// Gets the sample variance of the current window.
+//------------------------------------------------------------------------------
+// input:  *stats       pointer to the statistics state
+//
+// return: variance in raw measurement units^2 (0 for less than two samples)
+
+//==============================================================================
+ft Stats_GetQuantile(const stStatistics *stats);
+//==============================================================================
+// Gets the estimate of the p-quantile of the current window.
+//------------------------------------------------------------------------------
+// input:  *stats       pointer to the statistics state
+//
+// return: quantile in raw measurement units (0 if the window is empty)
+//
+// remark: Exact for up to 5 samples, an estimate with P afterwards.
+
+#endif
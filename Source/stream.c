@@ -0,0 +1,259 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  stream.c (V1.2)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  STM32F100RB
+// IDE       :  Vision V4.60.0.0
+// Compiler  :  Armcc
+// Brief     :  Binary streaming of timestamped raw samples over USART1 with
+//              DMA from double buffers, clock synchronization responses,
+//              statistics and reset gaps.
+//==============================================================================
+
+//-- Includes ------------------------------------------------------------------
+#include "stream.h"
+
+//-- Enumerations --------------------------------------------------------------
+// Buffer states
+typedef enum{
+  BUFFER_FILLING = 0, // samples are added to the buffer
+  BUFFER_READY   = 1, // frame complete, waiting for the DMA
+  BUFFER_SENDING = 2  // frame is being sent by the DMA
+}etBufferState;
+
+// Transmit buffers, in the order of their priority
+typedef enum{
+  TX_SYNC_RESPONSE = 0, // sync response, its delay counts for the sync
+  TX_RESET_GAP     = 1, // sample gap caused by a sensor reset
+  TX_STATISTICS    = 2, // statistics of a complete window
+  TX_SAMPLES_0     = 3, // samples, double buffer
+  TX_SAMPLES_1     = 4, //
+  NBR_OF_TX_BUFFERS
+}etTxBuffer;
+
+//-- Global Variables ----------------------------------------------------------
+static u8t           samplesBuffer[2][STREAM_FRAME_SIZE]; // sample frames
+static u8t           syncBuffer[STREAM_SYNC_RESPONSE_SIZE]; // sync response
+static u8t           resetBuffer[STREAM_RESET_GAP_SIZE];    // reset gap
+static u8t           statsBuffer[STREAM_STATISTICS_SIZE];   // statistics
+
+static u8t* const    txFrame[NBR_OF_TX_BUFFERS] = {
+  syncBuffer, resetBuffer, statsBuffer, samplesBuffer[0], samplesBuffer[1]
+};
+static const u8t     txSize[NBR_OF_TX_BUFFERS] = {
+  STREAM_SYNC_RESPONSE_SIZE, STREAM_RESET_GAP_SIZE, STREAM_STATISTICS_SIZE,
+  STREAM_FRAME_SIZE, STREAM_FRAME_SIZE
+};
+static volatile u8t  txState[NBR_OF_TX_BUFFERS];    // etBufferState
+
+static u8t           fillIndex = TX_SAMPLES_0;      // buffer being filled
+static u8t           fillCount = 0;                 // samples in fill buffer
+static u16t          sequence  = 0;                 // next sequence number
+static u32t          overruns  = 0;                 // dropped samples
+
+static u8t           lastSyncId = 0;                // id of the last response
+static u64t          lastSyncTx = 0;                // its transmission start
+
+static u8t           rxBuffer[STREAM_SYNC_REQUEST_SIZE]; // sync request
+static u8t           rxCount = 0;                   // received request bytes
+static u64t          rxTicks = 0;                   // time of the first byte
+
+//==============================================================================
+static void Stream_StartDma(u8t *frame, u16t size){
+//==============================================================================
+  DMA1_Channel4->CCR  &= ~0x00000001;            // channel disabled
+  DMA1_Channel4->CMAR  = (u32t)frame;
+  DMA1_Channel4->CNDTR = size;
+  DMA1_Channel4->CCR  |= 0x00000001;             // channel enabled
+}
+
+//==============================================================================
+static void Stream_StartTransmission(void){
+//==============================================================================
+  u32t primask; // interrupt mask on entry
+  u8t  i;       // buffer index
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+
+  // start the DMA with the complete frame of the highest priority, if it is
+  // idle
+  for(i = 0; i < NBR_OF_TX_BUFFERS && txState[i] != BUFFER_SENDING; i++);
+  if(i == NBR_OF_TX_BUFFERS)
+  {
+    for(i = 0; i < NBR_OF_TX_BUFFERS; i++)
+    {
+      if(txState[i] == BUFFER_READY)
+      {
+        // the start time of a sync response is sent with the next response
+        if(i == TX_SYNC_RESPONSE)
+        {
+          lastSyncId = syncBuffer[3];
+          lastSyncTx = Timer_GetTicks();
+        }
+        txState[i] = BUFFER_SENDING;
+        Stream_StartDma(txFrame[i], txSize[i]);
+        break;
+      }
+    }
+  }
+
+  __set_PRIMASK(primask);
+}
+
+//==============================================================================
+static void Stream_HandleSyncRequest(void){
+//==============================================================================
+  // ignore requests while the last response is busy and corrupted requests,
+  // the host repeats them
+  if(txState[TX_SYNC_RESPONSE] != BUFFER_FILLING)
+    return;
+  if(Stream_EncodeSyncResponse(syncBuffer, rxBuffer, rxTicks, lastSyncId,
+                               lastSyncTx) != NO_ERROR)
+    return;
+
+  txState[TX_SYNC_RESPONSE] = BUFFER_READY;
+  Stream_StartTransmission();
+}
+
+//==============================================================================
+void Stream_Init(void){
+//==============================================================================
+  u8t i; // buffer index
+
+  RCC->APB2ENR |= 0x00004004;  // USART1 and I/O port A clock enabled
+  RCC->AHBENR  |= 0x00000001;  // DMA1 clock enabled
+
+  GPIOA->CRH   &= 0xFFFFF00F;  // set alternate function push-pull output
+  GPIOA->CRH   |= 0x000004A0;  // for TX (port A, bit 9), 2MHz, and floating
+                               // input for RX (port A, bit 10)
+
+  USART1->BRR   = 0x0045;      // 8MHz / 115200 = 4.34 (mantissa 4, frac. 5)
+  USART1->CR3   = 0x0080;      // DMA mode for transmission enabled
+  USART1->CR1   = 0x202C;      // USART, transmitter, receiver and receive
+                               // interrupt enabled
+
+  // memory to peripheral, memory increment, transfer complete interrupt
+  DMA1_Channel4->CPAR = (u32t)&USART1->DR;
+  DMA1_Channel4->CCR  = 0x00000092;
+
+  for(i = 0; i < NBR_OF_TX_BUFFERS; i++)
+    txState[i] = BUFFER_FILLING;
+
+  NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+  NVIC_EnableIRQ(USART1_IRQn);
+}
+
+//==============================================================================
+void DMA1_Channel4_IRQHandler(void){
+//==============================================================================
+  u8t i; // buffer index
+
+  DMA1->IFCR = 0x0000F000;     // clear all flags of channel 4
+
+  // the buffer can be filled again, continue with a waiting frame
+  for(i = 0; i < NBR_OF_TX_BUFFERS; i++)
+    if(txState[i] == BUFFER_SENDING) txState[i] = BUFFER_FILLING;
+
+  Stream_StartTransmission();
+}
+
+//==============================================================================
+void USART1_IRQHandler(void){
+//==============================================================================
+  u8t rxByte; // received byte
+
+  if((USART1->SR & 0x0020) == 0) return; // no received data
+
+  // reading the data register also clears an overrun
+  rxByte = (u8t)USART1->DR;
+
+  // the arrival of the first byte is the receive time of the request
+  if(rxCount == 0)
+  {
+    if(rxByte != STREAM_SYNC_1) return;
+    rxTicks = Timer_GetTicks();
+  }
+  else if((rxCount == 1 && rxByte != STREAM_SYNC_2) ||
+          (rxCount == 2 && rxByte != STREAM_TYPE_SYNC_REQUEST))
+  {
+    rxCount = 0;
+    return;
+  }
+
+  rxBuffer[rxCount++] = rxByte;
+
+  if(rxCount == STREAM_SYNC_REQUEST_SIZE)
+  {
+    rxCount = 0;
+    Stream_HandleSyncRequest();
+  }
+}
+
+//==============================================================================
+etError Stream_AddSample(u64t timestamp, u16t result){
+//==============================================================================
+  u8t *frame = txFrame[fillIndex];
+
+  // both buffers are busy -> drop the sample
+  if(txState[fillIndex] != BUFFER_FILLING)
+  {
+    overruns++;
+    return OVERRUN_ERROR;
+  }
+
+  Stream_PutSample(frame, fillCount, timestamp, result);
+
+  // if the frame is complete, add header and checksum and send it
+  if(++fillCount == STREAM_SAMPLES_PER_FRAME)
+  {
+    Stream_FinishSamples(frame, STREAM_SAMPLES_PER_FRAME, sequence);
+    sequence++;
+
+    txState[fillIndex] = BUFFER_READY;
+    fillIndex = (fillIndex == TX_SAMPLES_0) ? TX_SAMPLES_1 : TX_SAMPLES_0;
+    fillCount = 0;
+    Stream_StartTransmission();
+  }
+
+  return NO_ERROR;
+}
+
+//==============================================================================
+etError Stream_AddStatistics(u64t timestamp, const stStatistics *stats){
+//==============================================================================
+  // a window lasts much longer than its transmission, so this only happens if
+  // the DMA is stuck
+  if(txState[TX_STATISTICS] != BUFFER_FILLING) return OVERRUN_ERROR;
+
+  Stream_EncodeStatistics(statsBuffer, timestamp, stats);
+
+  txState[TX_STATISTICS] = BUFFER_READY;
+  Stream_StartTransmission();
+
+  return NO_ERROR;
+}
+
+//==============================================================================
+etError Stream_AddResetGap(u64t timestamp, u32t gap){
+//==============================================================================
+  // a reset takes much longer than the transmission, so this only happens if
+  // the DMA is stuck
+  if(txState[TX_RESET_GAP] != BUFFER_FILLING) return OVERRUN_ERROR;
+
+  Stream_EncodeResetGap(resetBuffer, timestamp, gap);
+
+  txState[TX_RESET_GAP] = BUFFER_READY;
+  Stream_StartTransmission();
+
+  return NO_ERROR;
+}
+
+//==============================================================================
+u32t Stream_GetOverruns(void){
+//==============================================================================
+  return overruns;
+}
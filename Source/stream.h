@@ -0,0 +1,228 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  stream.h (V1.2)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  STM32F100RB
+// IDE       :  Vision V4.60.0.0
+// Compiler  :  Armcc
+// Brief     :  Binary streaming of timestamped raw samples over USART1 (TX on
+//              PA9, RX on PA10, 115200 baud, 8N1). Samples are collected into
+//              frames in one of two buffers, while the other one is sent with
+//              DMA, so the CPU never waits for the transmission. The host may
+//              send clock synchronization requests, which are answered with
+//              the device time, so that it can map the sample timestamps onto
+//              its own time line. The results of each complete statistics
+//              window and the sample gaps caused by sensor resets are sent as
+//              well.
+//==============================================================================
+// Frame layout (all multi-byte values little endian). Each frame starts with
+// the sync bytes (0xA5, 0x5A) and the frame type, and ends with a checksum
+// over all bytes from the frame type on (same CRC as the sensor, see
+// SF05_CalcCrc).
+//
+// Samples (device -> host):
+//   byte 2     STREAM_TYPE_SAMPLES
+//   byte 3     number of samples n
+//   byte 4..5  sequence number, incremented for each frame
+//   byte 6..   n samples, each: u64 timestamp [ticks, see Timer_GetTicks],
+//              u16 raw measurement result
+//
+// Sync request (host -> device):
+//   byte 2     STREAM_TYPE_SYNC_REQUEST
+//   byte 3     request id
+//   byte 4..11 u64 host time t1 when the request was sent (opaque to device)
+//
+// Sync response (device -> host):
+//   byte 2     STREAM_TYPE_SYNC_RESPONSE
+//   byte 3     request id
+//   byte 4..11 u64 host time t1 of the request (echoed)
+//   byte 12..19 u64 device time t2 when the first byte of the request arrived
+//   byte 20    request id of the previous response
+//   byte 21..28 u64 device time t3 when the transmission of the previous
+//              response started (0 if there was none)
+//
+// Statistics (device -> host), sent when a window is complete (see stats.h):
+//   byte 2     STREAM_TYPE_STATISTICS
+//   byte 3..10 u64 timestamp of the last sample of the window [ticks]
+//   byte 11..14 u32 number of samples
+//   byte 15..16 u16 min, byte 17..18 u16 max [raw measurement units]
+//   byte 19..22 f32 mean, byte 23..26 f32 variance, byte 27..30 f32 p,
+//              byte 31..34 f32 p-quantile (IEEE 754 single precision)
+//
+// Reset gap (device -> host), sent with the first sample after a sensor reset:
+//   byte 2     STREAM_TYPE_RESET_GAP
+//   byte 3..10 u64 timestamp of the first sample after the reset [ticks]
+//   byte 11..14 u32 time since the last sample before the reset [ticks]
+//
+// The start of a transmission is only known when the checksum is already
+// computed, so t3 of a response is delivered with the next response (like the
+// follow-up message of IEEE 1588).
+//==============================================================================
+
+#ifndef STREAM_H
+#define STREAM_H
+
+//-- Includes ------------------------------------------------------------------
+#include "system.h"
+#include "stats.h"
+
+//-- Defines -------------------------------------------------------------------
+#define STREAM_SYNC_1             0xA5 // first sync byte
+#define STREAM_SYNC_2             0x5A // second sync byte
+#define STREAM_TYPE_SAMPLES       0x01 // frame type: samples
+#define STREAM_TYPE_SYNC_REQUEST  0x02 // frame type: sync request
+#define STREAM_TYPE_SYNC_RESPONSE 0x03 // frame type: sync response
+#define STREAM_TYPE_STATISTICS    0x04 // frame type: statistics
+#define STREAM_TYPE_RESET_GAP     0x05 // frame type: reset gap
+
+#define STREAM_SAMPLES_PER_FRAME  16   // samples collected per frame
+#define STREAM_HEADER_SIZE        6    // sync, type, count, sequence
+#define STREAM_SAMPLE_SIZE        10   // timestamp, result
+#define STREAM_FRAME_SIZE         (STREAM_HEADER_SIZE + STREAM_SAMPLE_SIZE * \
+                                   STREAM_SAMPLES_PER_FRAME + 1)
+
+#define STREAM_SYNC_REQUEST_SIZE  13   // size of a sync request frame
+#define STREAM_SYNC_RESPONSE_SIZE 30   // size of a sync response frame
+#define STREAM_STATISTICS_SIZE    36   // size of a statistics frame
+#define STREAM_RESET_GAP_SIZE     16   // size of a reset gap frame
+
+#define STREAM_BAUDRATE           115200
+
+//==============================================================================
+void Stream_Init(void);
+//==============================================================================
+// Initializes USART1 and DMA1 channel 4 for the transmission and the receive
+// interrupt for the sync requests.
+//------------------------------------------------------------------------------
+
+//==============================================================================
+etError Stream_AddSample(u64t timestamp, u16t result);
+//==============================================================================
+// Adds a sample to the current frame. A complete frame is handed over to the
+// DMA, the function never waits for the transmission.
+//------------------------------------------------------------------------------
+// input:  timestamp    time of the sample in ticks (see Timer_GetTicks)
+//         result       raw measurement result
+//
+// return: error:       OVERRUN_ERROR = both buffers busy, sample dropped
+//                      NO_ERROR      = no error
+
+//==============================================================================
+etError Stream_AddStatistics(u64t timestamp, const stStatistics *stats);
+//==============================================================================
+// Sends the results of a complete statistics window.
+//------------------------------------------------------------------------------
+// input:  timestamp    time of the last sample of the window in ticks
+//         *stats       statistics, see Stats_Update
+//
+// return: error:       OVERRUN_ERROR = last statistics still busy, dropped
+//                      NO_ERROR      = no error
+
+//==============================================================================
+etError Stream_AddResetGap(u64t timestamp, u32t gap);
+//==============================================================================
+// Sends the sample gap caused by a sensor reset.
+//------------------------------------------------------------------------------
+// input:  timestamp    time of the first sample after the reset in ticks
+//         gap          time since the last sample before the reset in ticks
+//
+// return: error:       OVERRUN_ERROR = last reset gap still busy, dropped
+//                      NO_ERROR      = no error
+
+//==============================================================================
+u32t Stream_GetOverruns(void);
+//==============================================================================
+// Gets the number of samples dropped due to buffer overruns.
+//------------------------------------------------------------------------------
+
+//==============================================================================
+void Stream_PutU64(u8t *data, u64t value);
+//==============================================================================
+// Writes a 64-bit value in little endian byte order.
+//------------------------------------------------------------------------------
+// input:  *data        destination, 8 bytes
+//         value        value to be written
+
+//==============================================================================
+u64t Stream_GetU64(const u8t *data);
+//==============================================================================
+// Reads a 64-bit value in little endian byte order (decoding on the host).
+//------------------------------------------------------------------------------
+// input:  *data        source, 8 bytes
+//
+// return: value
+
+//==============================================================================
+void Stream_PutSample(u8t *frame, u8t index, u64t timestamp, u16t result);
+//==============================================================================
+// Writes a sample into a samples frame.
+//------------------------------------------------------------------------------
+// input:  *frame       samples frame
+//         index        position of the sample in the frame
+//         timestamp    time of the sample in ticks (see Timer_GetTicks)
+//         result       raw measurement result
+
+//==============================================================================
+void Stream_FinishFrame(u8t *frame, u8t type, u8t size);
+//==============================================================================
+// Adds the sync bytes, the frame type and the checksum to a frame, whose
+// payload is already written.
+//------------------------------------------------------------------------------
+// input:  *frame       frame
+//         type         frame type (STREAM_TYPE_...)
+//         size         size of the frame including the checksum
+
+//==============================================================================
+u8t Stream_FinishSamples(u8t *frame, u8t count, u16t sequence);
+//==============================================================================
+// Adds the header and the checksum to a samples frame, whose samples are
+// already written with Stream_PutSample.
+//------------------------------------------------------------------------------
+// input:  *frame       samples frame
+//         count        number of samples in the frame
+//         sequence     sequence number of the frame
+//
+// return: size of the frame
+//
+//==============================================================================
+void Stream_EncodeStatistics(u8t *frame, u64t timestamp,
+                             const stStatistics *stats);
+//==============================================================================
+// Encodes a statistics frame of STREAM_STATISTICS_SIZE bytes.
+//------------------------------------------------------------------------------
+// input:  *frame       frame buffer
+//         timestamp    time of the last sample of the window in ticks
+//         *stats       statistics
+
+//==============================================================================
+void Stream_EncodeResetGap(u8t *frame, u64t timestamp, u32t gap);
+//==============================================================================
+// Encodes a reset gap frame of STREAM_RESET_GAP_SIZE bytes.
+//------------------------------------------------------------------------------
+// input:  *frame       frame buffer
+//         timestamp    time of the first sample after the reset in ticks
+//         gap          time since the last sample before the reset in ticks
+
+//==============================================================================
+etError Stream_EncodeSyncResponse(u8t *frame, const u8t *request, u64t t2,
+                                  u8t lastId, u64t lastT3);
+//==============================================================================
+// Checks a received sync request and encodes the response frame of
+// STREAM_SYNC_RESPONSE_SIZE bytes.
+//------------------------------------------------------------------------------
+// input:  *frame       frame buffer
+//         *request     received sync request frame
+//         t2           time when the first byte of the request arrived
+//         lastId       request id of the previous response
+//         lastT3       transmission start of the previous response (0 = none)
+//
+// return: error:       CHECKSUM_ERROR = corrupted request, no response
+//                      NO_ERROR       = no error
+//
+// remark: The Stream_Put.., Stream_Finish.. and Stream_Encode.. functions do
+//         not access the controller (see stream_frame.c).
+
+#endif
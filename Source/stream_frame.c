@@ -0,0 +1,142 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  stream_frame.c (V1.1)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  STM32F100RB
+// IDE       :  Vision V4.60.0.0
+// Compiler  :  Armcc
+// Brief     :  Hardware independent encoding of the stream frames. This file
+//              does not access the controller and is also built into the host
+//              tests (see Tools/).
+//==============================================================================
+
+//-- Includes ------------------------------------------------------------------
+#include "stream.h"
+#include "sf05.h"
+
+#include <stdint.h>
+#include <string.h>
+
+//==============================================================================
+void Stream_PutU64(u8t *data, u64t value){
+//==============================================================================
+  u8t i; // byte index
+
+  for(i = 0; i < 8; i++)
+  {
+    data[i] = (u8t)value;
+    value >>= 8;
+  }
+}
+
+//==============================================================================
+u64t Stream_GetU64(const u8t *data){
+//==============================================================================
+  u64t value = 0; // read value
+  u8t  i;         // byte index
+
+  for(i = 8; i > 0; i--)
+    value = (value << 8) | data[i - 1];
+  return value;
+}
+
+//==============================================================================
+static void Stream_PutU32(u8t *data, u32t value){
+//==============================================================================
+  data[0] = (u8t)(value);
+  data[1] = (u8t)(value >> 8);
+  data[2] = (u8t)(value >> 16);
+  data[3] = (u8t)(value >> 24);
+}
+
+//==============================================================================
+static void Stream_PutFloat(u8t *data, ft value){
+//==============================================================================
+  uint32_t bits; // IEEE 754 single precision on both sides; u32t is 8 bytes
+                 // on LP64 hosts, where this file is built into the tests
+
+  memcpy(&bits, &value, sizeof(bits));
+  Stream_PutU32(data, bits);
+}
+
+//==============================================================================
+void Stream_PutSample(u8t *frame, u8t index, u64t timestamp, u16t result){
+//==============================================================================
+  u8t *sample = &frame[STREAM_HEADER_SIZE + STREAM_SAMPLE_SIZE * index];
+
+  Stream_PutU64(sample, timestamp);
+  sample[8] = (u8t)(result);
+  sample[9] = (u8t)(result >> 8);
+}
+
+//==============================================================================
+void Stream_FinishFrame(u8t *frame, u8t type, u8t size){
+//==============================================================================
+  frame[0] = STREAM_SYNC_1;
+  frame[1] = STREAM_SYNC_2;
+  frame[2] = type;
+  frame[size - 1] = SF05_CalcCrc(&frame[2], size - 3);
+}
+
+//==============================================================================
+u8t Stream_FinishSamples(u8t *frame, u8t count, u16t sequence){
+//==============================================================================
+  u8t size = STREAM_HEADER_SIZE + STREAM_SAMPLE_SIZE * count + 1;
+
+  frame[3] = count;
+  frame[4] = (u8t)(sequence);
+  frame[5] = (u8t)(sequence >> 8);
+  Stream_FinishFrame(frame, STREAM_TYPE_SAMPLES, size);
+
+  return size;
+}
+
+//==============================================================================
+void Stream_EncodeStatistics(u8t *frame, u64t timestamp,
+                             const stStatistics *stats){
+//==============================================================================
+  Stream_PutU64(&frame[3], timestamp);
+  Stream_PutU32(&frame[11], stats->count);
+  frame[15] = (u8t)(stats->min);
+  frame[16] = (u8t)(stats->min >> 8);
+  frame[17] = (u8t)(stats->max);
+  frame[18] = (u8t)(stats->max >> 8);
+  Stream_PutFloat(&frame[19], Stats_GetMean(stats));
+  Stream_PutFloat(&frame[23], Stats_GetVariance(stats));
+  Stream_PutFloat(&frame[27], stats->p);
+  Stream_PutFloat(&frame[31], Stats_GetQuantile(stats));
+  Stream_FinishFrame(frame, STREAM_TYPE_STATISTICS, STREAM_STATISTICS_SIZE);
+}
+
+//==============================================================================
+void Stream_EncodeResetGap(u8t *frame, u64t timestamp, u32t gap){
+//==============================================================================
+  Stream_PutU64(&frame[3], timestamp);
+  Stream_PutU32(&frame[11], gap);
+  Stream_FinishFrame(frame, STREAM_TYPE_RESET_GAP, STREAM_RESET_GAP_SIZE);
+}
+
+//==============================================================================
+etError Stream_EncodeSyncResponse(u8t *frame, const u8t *request, u64t t2,
+                                  u8t lastId, u64t lastT3){
+//==============================================================================
+  u8t i; // byte index
+
+  if(SF05_CheckCrc((u8t *)&request[2], STREAM_SYNC_REQUEST_SIZE - 3,
+                   request[STREAM_SYNC_REQUEST_SIZE - 1]) != NO_ERROR)
+    return CHECKSUM_ERROR;
+
+  frame[3] = request[3];                         // request id
+  for(i = 0; i < 8; i++)
+    frame[4 + i] = request[4 + i];               // t1
+  Stream_PutU64(&frame[12], t2);
+  frame[20] = lastId;
+  Stream_PutU64(&frame[21], lastT3);             // t3 of the last response
+  Stream_FinishFrame(frame, STREAM_TYPE_SYNC_RESPONSE,
+                     STREAM_SYNC_RESPONSE_SIZE);
+
+  return NO_ERROR;
+}
@@ -2,9 +2,9 @@
 //    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
 //==============================================================================
 // Project   :  SF05 Sample Code (V1.1)
-// File      :  system.c (V1.0)
+// File      :  system.c (V1.2)
 // Author    :  RFU
-// Date      :  07-Nov-2012
+// Date      :  19-Oct-2026
 // Controller:  STM32F100RB
 // IDE       :  Vision V4.60.0.0
 // Compiler  :  Armcc
@@ -14,6 +14,9 @@
 //-- Includes ------------------------------------------------------------------
 #include "system.h"
 
+//-- Global Variables ----------------------------------------------------------
+static volatile u64t timerOverflows = 0; // upper 48 bits of the timer
+
 //==============================================================================
 void SystemInit(void)
 //==============================================================================
@@ -35,3 +38,52 @@ void DelayMicroSeconds(u32t nbrOfUs)
   }
 }
 
+//==============================================================================
+void Timer_Init(void)
+//==============================================================================
+{
+  RCC->APB1ENR |= 0x00000001;  // TIM2 clock enabled
+
+  TIM2->PSC     = 7;           // 8MHz / (7 + 1) = 1MHz
+  TIM2->ARR     = 0xFFFF;      // free-running over the full 16 bits
+  TIM2->EGR     = 0x0001;      // load prescaler
+  TIM2->SR      = 0x0000;      // clear update flag caused by EGR
+  TIM2->DIER    = 0x0001;      // update interrupt enabled
+  TIM2->CR1     = 0x0001;      // counter enabled
+
+  NVIC_EnableIRQ(TIM2_IRQn);
+}
+
+//==============================================================================
+void TIM2_IRQHandler(void)
+//==============================================================================
+{
+  if(TIM2->SR & 0x0001)
+  {
+    TIM2->SR = (u16t)~0x0001;  // clear update flag
+    timerOverflows++;
+  }
+}
+
+//==============================================================================
+u64t Timer_GetTicks(void)
+//==============================================================================
+{
+  u32t primask; // interrupt mask on entry
+  u64t high;    // upper 48 bits
+  u16t low;     // lower 16 bits
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  high = timerOverflows;
+  low  = TIM2->CNT;
+  // overflow not yet counted by the interrupt (e.g. called from an interrupt)
+  if(TIM2->SR & 0x0001)
+  {
+    high++;
+    low = TIM2->CNT;
+  }
+  __set_PRIMASK(primask);
+
+  return (high << 16) | low;
+}
@@ -2,9 +2,9 @@
 //    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
 //==============================================================================
 // Project   :  SF05 Sample Code (V1.1)
-// File      :  system.h (V1.0)
+// File      :  system.h (V1.1)
 // Author    :  RFU
-// Date      :  07-Nov-2012
+// Date      :  19-Oct-2026
 // Controller:  STM32F100RB
 // IDE       :  Vision V4.60.0.0
 // Compiler  :  Armcc
@@ -18,12 +18,17 @@
 #include <stm32f10x.h>             // controller register definitions
 #include "typedefs.h"              // type definitions
 
+//-- Defines -------------------------------------------------------------------
+#define TIMER_TICKS_PER_SECOND 1000000 // resolution of Timer_GetTicks()
+
 //-- Enumerations --------------------------------------------------------------
 // Error codes
 typedef enum{
-  NO_ERROR       = 0x00, // no error
-  ACK_ERROR      = 0x01, // no acknowledgment error
-  CHECKSUM_ERROR = 0x02  // checksum mismatch error
+  NO_ERROR        = 0x00, // no error
+  ACK_ERROR       = 0x01, // no acknowledgment error
+  CHECKSUM_ERROR  = 0x02, // checksum mismatch error
+  OVERRUN_ERROR   = 0x04, // buffer overrun error
+  PARAMETER_ERROR = 0x08  // invalid parameter error
 }etError;
 
 //==============================================================================
@@ -41,4 +46,19 @@ void DelayMicroSeconds(u32t nbrOfUs);
 // return: -
 // remark: smallest delay is approx. 15us due to function call
 
+//==============================================================================
+void Timer_Init(void);
+//==============================================================================
+// Starts the free-running timer (TIM2, 1MHz). The 16-bit counter is extended
+// to 64 bits in the update interrupt.
+//------------------------------------------------------------------------------
+
+//==============================================================================
+u64t Timer_GetTicks(void);
+//==============================================================================
+// Gets the monotonic time since Timer_Init().
+//------------------------------------------------------------------------------
+// return: time in ticks of 1us (TIMER_TICKS_PER_SECOND)
+// remark: may also be called from interrupts and with interrupts disabled
+
 #endif
@@ -2,9 +2,9 @@
 //    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
 //==============================================================================
 // Project   :  SF05 Sample Code (V1.1)
-// File      :  typedefs.h (V1.0)
+// File      :  typedefs.h (V1.1)
 // Author    :  RFU
-// Date      :  07-Nov-2012
+// Date      :  19-Oct-2026
 // Controller:  STM32F100RB
 // IDE       :  Vision V4.60.0.0
 // Compiler  :  Armcc
@@ -30,6 +30,9 @@ typedef signed short    i16t;     ///< range: -32768 .. +32767
 typedef unsigned long   u32t;     ///< range: 0 .. 4'294'967'295
 typedef signed long     i32t;     ///< range: -2'147'483'648 .. +2'147'483'647
                                       
+typedef unsigned long long u64t;  ///< range: 0 .. 18'446'744'073'709'551'615
+typedef signed long long   i64t;  ///< range: -9.22E+18 .. +9.22E+18
+                                      
 typedef float           ft;       ///< range: +-1.18E-38 .. +-3.39E+38
 typedef double          dt;      ///< range:            .. +-1.79E+308
 
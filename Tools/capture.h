@@ -0,0 +1,151 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  capture.h (V1.1)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  Host (Linux)
+// Compiler  :  gcc
+// Brief     :  Layout of the capture files holding archived raw sensor
+//              readings.
+//==============================================================================
+// A capture file is a sequence of fixed size records. Each record holds one
+// reading exactly as it was received on the I2C bus.
+//
+// Version 2 (written by sf05_stream): a header, followed by the records.
+//
+//   header byte 0..3  "SF05"
+//   header byte 4     version (2)
+//   header byte 5     record size (12)
+//   header byte 6     time base: 0 = device ticks, 1 = host CLOCK_MONOTONIC
+//   header byte 7     0xFF (never 0, see version 1)
+//
+//   byte 0..7  timestamp in microseconds (little endian)
+//   byte 8     measurement result, high byte
+//   byte 9     measurement result, low byte
+//   byte 10    checksum as sent by the sensor
+//   byte 11    reserved (0)
+//
+// Version 1: records without header. A file is version 1 if it does not start
+// with a version 2 header; the byte 7 of a version 1 record is always 0.
+//
+//   byte 0..3  timestamp in microseconds (little endian, wraps around)
+//   byte 4     measurement result, high byte
+//   byte 5     measurement result, low byte
+//   byte 6     checksum as sent by the sensor
+//   byte 7     reserved (0)
+//==============================================================================
+
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+//-- Includes ------------------------------------------------------------------
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+//-- Defines -------------------------------------------------------------------
+#define CAPTURE_HEADER_SIZE   8    // size of the version 2 header in bytes
+#define CAPTURE_VERSION       2    // version written by Capture_SetHeader
+#define CAPTURE_RECORD_SIZE   12   // size of one record in bytes
+#define CAPTURE_OFS_TIMESTAMP 0    // offset of the timestamp
+#define CAPTURE_OFS_DATA      8    // offset of the two result bytes
+#define CAPTURE_OFS_CRC       10   // offset of the checksum
+
+#define CAPTURE_V1_RECORD_SIZE 8   // version 1: size of one record in bytes
+#define CAPTURE_V1_OFS_DATA    4   // version 1: offset of the result bytes
+#define CAPTURE_V1_OFS_CRC     6   // version 1: offset of the checksum
+
+#define CAPTURE_TIME_DEVICE   0    // timestamps are device ticks
+#define CAPTURE_TIME_HOST     1    // timestamps are host CLOCK_MONOTONIC
+
+//-- Type definitions ----------------------------------------------------------
+// Layout of a capture file, see Capture_GetLayout.
+typedef struct{
+  unsigned version;    // file version
+  unsigned timeBase;   // CAPTURE_TIME_..., device ticks for version 1
+  size_t   headerSize; // bytes before the first record
+  size_t   recordSize; // size of one record
+  size_t   ofsData;    // offset of the two result bytes
+  size_t   ofsCrc;     // offset of the checksum
+  uint64_t tsMask;     // valid timestamp bits, differences are taken modulo
+}tCaptureLayout;
+
+//==============================================================================
+static inline void Capture_GetLayout(const uint8_t *file, size_t size,
+                                     tCaptureLayout *layout){
+//==============================================================================
+  if(size >= CAPTURE_HEADER_SIZE && memcmp(file, "SF05", 4) == 0 &&
+     file[4] == CAPTURE_VERSION && file[5] == CAPTURE_RECORD_SIZE &&
+     file[7] == 0xFF)
+  {
+    layout->version    = CAPTURE_VERSION;
+    layout->timeBase   = file[6];
+    layout->headerSize = CAPTURE_HEADER_SIZE;
+    layout->recordSize = CAPTURE_RECORD_SIZE;
+    layout->ofsData    = CAPTURE_OFS_DATA;
+    layout->ofsCrc     = CAPTURE_OFS_CRC;
+    layout->tsMask     = UINT64_MAX;
+  }
+  else
+  {
+    layout->version    = 1;
+    layout->timeBase   = CAPTURE_TIME_DEVICE;
+    layout->headerSize = 0;
+    layout->recordSize = CAPTURE_V1_RECORD_SIZE;
+    layout->ofsData    = CAPTURE_V1_OFS_DATA;
+    layout->ofsCrc     = CAPTURE_V1_OFS_CRC;
+    layout->tsMask     = UINT32_MAX;
+  }
+}
+
+//==============================================================================
+static inline uint64_t Capture_GetTimestamp(const tCaptureLayout *layout,
+                                            const uint8_t *record){
+//==============================================================================
+  const uint8_t *ts = &record[CAPTURE_OFS_TIMESTAMP];
+  uint32_t       low;
+
+  low = (uint32_t)ts[0]         | ((uint32_t)ts[1] << 8)
+     | ((uint32_t)ts[2] << 16) | ((uint32_t)ts[3] << 24);
+  if(layout->version == 1) return low;
+
+  return low | ((uint64_t)((uint32_t)ts[4]         | ((uint32_t)ts[5] << 8)
+                        | ((uint32_t)ts[6] << 16) | ((uint32_t)ts[7] << 24))
+                << 32);
+}
+
+//==============================================================================
+static inline uint16_t Capture_GetResult(const tCaptureLayout *layout,
+                                         const uint8_t *record){
+//==============================================================================
+  return (uint16_t)((record[layout->ofsData] << 8) |
+                     record[layout->ofsData + 1]);
+}
+
+//==============================================================================
+static inline void Capture_SetHeader(uint8_t *header, unsigned timeBase){
+//==============================================================================
+  memcpy(header, "SF05", 4);
+  header[4] = CAPTURE_VERSION;
+  header[5] = CAPTURE_RECORD_SIZE;
+  header[6] = (uint8_t)timeBase;
+  header[7] = 0xFF;
+}
+
+//==============================================================================
+static inline void Capture_SetRecord(uint8_t *record, uint64_t timestamp,
+                                     uint16_t result, uint8_t crc){
+//==============================================================================
+  int i;
+
+  for(i = 0; i < 8; i++, timestamp >>= 8)
+    record[CAPTURE_OFS_TIMESTAMP + i] = (uint8_t)timestamp;
+  record[CAPTURE_OFS_DATA]     = (uint8_t)(result >> 8);
+  record[CAPTURE_OFS_DATA + 1] = (uint8_t)(result);
+  record[CAPTURE_OFS_CRC]      = crc;
+  record[11] = 0;
+}
+
+#endif
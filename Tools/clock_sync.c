@@ -0,0 +1,151 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  clock_sync.c (V1.0)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  Host (Linux)
+// Compiler  :  gcc
+// Brief     :  Host side of the clock synchronization with the firmware. The
+//              frames are encoded and decoded with the firmware functions
+//              (Source/stream_frame.c).
+//==============================================================================
+
+//-- Includes ------------------------------------------------------------------
+#include "host.h"
+#include "stream.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "clock_sync.h"
+
+//-- Defines -------------------------------------------------------------------
+// transmission time of one byte (start bit, 8 data bits, stop bit) [us]
+#define BYTE_US  (10.0 * 1e6 / STREAM_BAUDRATE)
+
+// exchanges with a delay up to the minimum + DELAY_SPREAD * |minimum| +
+// DELAY_MARGIN are used (the compensated minimum may be slightly negative)
+#define DELAY_SPREAD  0.5
+#define DELAY_MARGIN  50.0     // [us]
+#define FIT_MIN_POINTS 8       // exchanges used at least, if available
+
+//==============================================================================
+static int CompareDouble(const void *a, const void *b){
+//==============================================================================
+  double x = *(const double *)a, y = *(const double *)b;
+
+  return (x > y) - (x < y);
+}
+
+//==============================================================================
+static void ClockSync_Fit(tClockSync *cs){
+//==============================================================================
+  double   hostMean = 0.0, deviceMean = 0.0, sxx = 0.0, sxy = 0.0, limit;
+  double   delays[CLOCK_SYNC_HISTORY];
+  unsigned i, n = 0;
+
+  for(i = 0; i < cs->nbrOfPoints; i++) delays[i] = cs->points[i].delay;
+  qsort(delays, cs->nbrOfPoints, sizeof(delays[0]), CompareDouble);
+  cs->minDelay = delays[0];
+  limit = cs->minDelay + DELAY_SPREAD * fabs(cs->minDelay) + DELAY_MARGIN;
+
+  // with a large latency jitter only few exchanges are close to the minimum,
+  // a single one would leave the drift unknown -> use at least the best
+  // FIT_MIN_POINTS exchanges
+  i = (cs->nbrOfPoints < FIT_MIN_POINTS) ? cs->nbrOfPoints : FIT_MIN_POINTS;
+  if(delays[i - 1] > limit) limit = delays[i - 1];
+
+  // least squares line through the exchanges with small delays, centered
+  // on the means for numerical precision
+  for(i = 0; i < cs->nbrOfPoints; i++)
+  {
+    if(cs->points[i].delay > limit) continue;
+    hostMean   += cs->points[i].host;
+    deviceMean += cs->points[i].device;
+    n++;
+  }
+  hostMean   /= n;
+  deviceMean /= n;
+
+  for(i = 0; i < cs->nbrOfPoints; i++)
+  {
+    if(cs->points[i].delay > limit) continue;
+    sxx += (cs->points[i].host - hostMean) * (cs->points[i].host - hostMean);
+    sxy += (cs->points[i].host - hostMean) *
+           (cs->points[i].device - deviceMean);
+  }
+
+  cs->hostRef   = hostMean;
+  cs->deviceRef = deviceMean;
+  cs->rate      = (n >= 2 && sxx > 0.0) ? sxy / sxx : 1.0;
+  cs->used      = n;
+  cs->valid     = 1;
+}
+
+//==============================================================================
+void ClockSync_Init(tClockSync *cs){
+//==============================================================================
+  memset(cs, 0, sizeof(*cs));
+  cs->rate = 1.0;
+}
+
+//==============================================================================
+size_t ClockSync_BuildRequest(tClockSync *cs, uint8_t *frame, uint64_t now){
+//==============================================================================
+  // encoded with the firmware functions (stream_frame.c)
+  frame[3] = cs->nextId++;
+  Stream_PutU64(&frame[4], now);
+  Stream_FinishFrame(frame, STREAM_TYPE_SYNC_REQUEST, STREAM_SYNC_REQUEST_SIZE);
+  return STREAM_SYNC_REQUEST_SIZE;
+}
+
+//==============================================================================
+void ClockSync_HandleResponse(tClockSync *cs, const uint8_t *frame,
+                              uint64_t now){
+//==============================================================================
+  tSyncExchange *ex = &cs->last;
+  uint64_t       t3 = Stream_GetU64(&frame[21]);
+  tSyncPoint     point;
+
+  // complete the last received exchange with its transmission start t3; an
+  // older exchange never matches, its follow-up was lost
+  if(ex->pending && ex->id == frame[20] && t3 != 0 && t3 >= ex->t2)
+  {
+    point.host   = 0.5 * ((double)ex->t1 + (double)ex->t4);
+    point.device = 0.5 * ((double)ex->t2 + (double)t3);
+    point.delay  = ((double)ex->t4 - (double)ex->t1) -
+                   ((double)t3 - (double)ex->t2);
+
+    // the compensated delay is slightly negative at most, anything below
+    // is a wrong pairing and would otherwise become the minimum
+    if(point.delay >= CLOCK_SYNC_MIN_DELAY)
+    {
+      cs->points[cs->nextPoint] = point;
+      cs->nextPoint = (cs->nextPoint + 1) % CLOCK_SYNC_HISTORY;
+      if(cs->nbrOfPoints < CLOCK_SYNC_HISTORY) cs->nbrOfPoints++;
+      ClockSync_Fit(cs);
+    }
+  }
+
+  // t2 is taken when the first byte of the request arrived, t3 when the first
+  // byte of the response is sent -> compensate the byte times on the line;
+  // the new exchange replaces the last one, completed or not
+  ex->pending = 1;
+  ex->id      = frame[3];
+  ex->t1      = Stream_GetU64(&frame[4]) + (uint64_t)BYTE_US;
+  ex->t2      = Stream_GetU64(&frame[12]);
+  ex->t4      = now - (uint64_t)(STREAM_SYNC_RESPONSE_SIZE * BYTE_US);
+}
+
+//==============================================================================
+int ClockSync_ToHost(const tClockSync *cs, uint64_t ticks, uint64_t *host){
+//==============================================================================
+  if(!cs->valid) return 0;
+
+  *host = (uint64_t)(cs->hostRef +
+                     ((double)ticks - cs->deviceRef) / cs->rate + 0.5);
+  return 1;
+}
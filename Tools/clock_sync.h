@@ -0,0 +1,105 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  clock_sync.h (V1.0)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  Host (Linux)
+// Compiler  :  gcc
+// Brief     :  Host side of the clock synchronization with the firmware (sync
+//              request/response frames, see Source/stream.h). Estimates the
+//              offset and drift of the device timer relative to the host
+//              clock and maps device timestamps onto the host time line, so
+//              that data from several sensors and devices can be merged.
+//==============================================================================
+// Each exchange gives four times: t1 (host, request sent), t2 (device, request
+// received), t3 (device, response sent) and t4 (host, response received). The
+// byte transmission times on the serial line are compensated, the remaining
+// path delay is (t4 - t1) - (t3 - t2). The midpoints ((t1 + t4) / 2,
+// (t2 + t3) / 2) of the exchanges with the smallest delays are fitted with a
+// straight line, whose slope is the drift and whose intercept is the offset.
+// The t3 of a response can only complete the last received response; if that
+// follow-up is lost, the exchange is discarded. Exchanges with t3 < t2 or an
+// implausibly negative delay (below CLOCK_SYNC_MIN_DELAY) are rejected.
+//==============================================================================
+
+#ifndef CLOCK_SYNC_H
+#define CLOCK_SYNC_H
+
+//-- Includes ------------------------------------------------------------------
+#include <stddef.h>
+#include <stdint.h>
+
+//-- Defines -------------------------------------------------------------------
+#define CLOCK_SYNC_HISTORY   64      // number of exchanges kept for the fit
+#define CLOCK_SYNC_MIN_DELAY -1000.0 // smaller delays are rejected [us]
+
+//-- Type definitions ----------------------------------------------------------
+// One completed exchange.
+typedef struct{
+  double host;   // host time of the exchange (midpoint) [us]
+  double device; // device time of the exchange (midpoint) [ticks]
+  double delay;  // round trip delay without device processing [us]
+}tSyncPoint;
+
+// Exchange waiting for its t3, which arrives with the next response.
+typedef struct{
+  int      pending; // t1, t2 and t4 are valid
+  uint8_t  id;      // request id
+  uint64_t t1;      // host time, request sent (compensated) [us]
+  uint64_t t2;      // device time, request received [ticks]
+  uint64_t t4;      // host time, response received (compensated) [us]
+}tSyncExchange;
+
+// Clock synchronization state.
+typedef struct{
+  tSyncExchange last;                        // last received response
+  tSyncPoint    points[CLOCK_SYNC_HISTORY];  // completed exchanges (ring)
+  unsigned      nbrOfPoints;                 // valid entries in points
+  unsigned      nextPoint;                   // next entry to be written
+  uint8_t       nextId;                      // id of the next request
+  int           valid;                       // estimate available
+  double        hostRef;                     // host reference time [us]
+  double        deviceRef;                   // device time at hostRef [ticks]
+  double        rate;                        // device ticks per host us
+  double        minDelay;                    // smallest delay in the history
+  unsigned      used;                        // exchanges used for the fit
+}tClockSync;
+
+//==============================================================================
+void ClockSync_Init(tClockSync *cs);
+//==============================================================================
+// Initializes the clock synchronization state.
+//------------------------------------------------------------------------------
+
+//==============================================================================
+size_t ClockSync_BuildRequest(tClockSync *cs, uint8_t *frame, uint64_t now);
+//==============================================================================
+// Builds a sync request frame. Send it right away after calling.
+//------------------------------------------------------------------------------
+// input:  *frame       buffer for STREAM_SYNC_REQUEST_SIZE bytes
+//         now          host time [us]
+//
+// return: size of the frame
+
+//==============================================================================
+void ClockSync_HandleResponse(tClockSync *cs, const uint8_t *frame,
+                              uint64_t now);
+//==============================================================================
+// Processes a received sync response frame (checksum already verified).
+//------------------------------------------------------------------------------
+// input:  *frame       sync response frame
+//         now          host time when the frame was received [us]
+
+//==============================================================================
+int ClockSync_ToHost(const tClockSync *cs, uint64_t ticks, uint64_t *host);
+//==============================================================================
+// Maps a device timestamp onto the host time line.
+//------------------------------------------------------------------------------
+// input:  ticks        device time [ticks]
+//         *host        host time [us]
+//
+// return: 1 = mapped, 0 = no estimate available yet
+
+#endif
@@ -0,0 +1,26 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  host.h (V1.0)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  Host (Linux)
+// Compiler  :  gcc
+// Brief     :  Common include of the host tools. Includes the driver type
+//              definitions before any system header and adapts them to the
+//              host C library: typedefs.h defines an empty LITTLE_ENDIAN,
+//              which clashes with the definition in <endian.h>. Include this
+//              file first in every host source using the driver headers.
+//==============================================================================
+
+#ifndef HOST_H
+#define HOST_H
+
+//-- Includes ------------------------------------------------------------------
+#include "system.h"
+
+// only needed by the byte order unions in typedefs.h, evaluated above
+#undef LITTLE_ENDIAN
+
+#endif
@@ -0,0 +1,19 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  stm32f10x.h (V1.0)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  Host (Linux)
+// Compiler  :  gcc
+// Brief     :  Host stand-in for the controller register definitions. It only
+//              allows the hardware independent sources (e.g. sf05_calc.c) to
+//              be compiled into the host tools. Sources accessing registers
+//              must not be built against this file.
+//==============================================================================
+
+#ifndef STM32F10X_H
+#define STM32F10X_H
+
+#endif
@@ -0,0 +1,342 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  sf05_analyze.c (V1.1)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  Host (Linux)
+// Compiler  :  gcc
+// Brief     :  Offline analysis of captured flow runs (see capture.h). The
+//              capture file is memory-mapped, split into one chunk per thread
+//              and the chunks are processed in parallel: checksum
+//              verification, conversion, totals, min/max/mean and gap
+//              detection. The partial results are merged in file order.
+//              Both capture versions are accepted (see capture.h).
+//              Checksum and conversion are taken from the driver sources
+//              (sf05_calc.c), so the results match the firmware exactly.
+//
+// Build:   gcc -O2 -pthread -ISource -ITools/host -o sf05_analyze
+//              Tools/sf05_analyze.c Source/sf05_calc.c
+//
+// Usage:   sf05_analyze [-j threads] [-o offset] [-s scale] [-g gap_us] file..
+//==============================================================================
+
+//-- Includes ------------------------------------------------------------------
+#include "host.h"
+#include "sf05.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "capture.h"
+
+//-- Defines -------------------------------------------------------------------
+// Offset and scale factors from datasheet (SFM3000), Air/N2 (see calib.c).
+#define OFFSET_FLOW 32000.0F   // offset flow
+#define SCALE_FLOW    140.0F   // scale factor flow
+
+#define GAP_US       150000    // default gap threshold (1.5 x 100ms period)
+#define MAX_THREADS  256       // upper limit for the number of threads
+
+//-- Type definitions ----------------------------------------------------------
+// Partial result of one chunk, merged in file order afterwards.
+typedef struct{
+  const tCaptureLayout *layout; // layout of the capture file
+  const uint8_t *records;      // first record of the chunk
+  size_t         nbrOfRecords; // number of records in the chunk
+  uint64_t       crcErrors;    // records with checksum mismatch
+  uint64_t       gaps;         // timestamp deltas above the threshold
+  uint64_t       maxDeltaUs;   // largest timestamp delta
+  uint16_t       minResult;    // smallest valid raw result
+  uint16_t       maxResult;    // largest valid raw result
+  double         sumFlow;      // sum of all valid flow values
+  double         volume;       // integrated flow [unit * us]
+  uint64_t       firstTs;      // timestamp of the first record
+  uint64_t       lastTs;       // timestamp of the last record
+  int            hasValid;     // at least one valid record in the chunk
+  uint64_t       firstValidTs; // timestamp of the first valid record
+  ft             firstFlow;    // flow of the first valid record
+  uint64_t       lastValidTs;  // timestamp of the last valid record
+  ft             lastFlow;     // flow of the last valid record
+}tChunk;
+
+//-- Global Variables ----------------------------------------------------------
+static ft       offsetFlow = OFFSET_FLOW;
+static ft       scaleFlow  = SCALE_FLOW;
+static uint32_t gapUs      = GAP_US;
+
+//==============================================================================
+static void *ProcessChunk(void *arg){
+//==============================================================================
+  tChunk               *chunk  = (tChunk *)arg;
+  const tCaptureLayout *layout = chunk->layout;
+  const uint8_t        *record = chunk->records;
+  const uint8_t        *end    = record +
+                                 chunk->nbrOfRecords * layout->recordSize;
+  const uint64_t        mask   = layout->tsMask;
+  uint64_t crcErrors    = 0;
+  uint64_t gaps         = 0;
+  uint64_t maxDeltaUs   = 0;
+  uint16_t minResult    = 0xFFFF;
+  uint16_t maxResult    = 0x0000;
+  double   sumFlow      = 0.0;
+  double   volume       = 0.0;
+  int      hasValid     = 0;
+  uint64_t prevTs       = Capture_GetTimestamp(layout, record);
+  uint64_t prevValidTs  = 0;
+  ft       prevFlow     = 0.0F;
+
+  chunk->firstTs = prevTs;
+
+  for(; record < end; record += layout->recordSize)
+  {
+    uint64_t ts    = Capture_GetTimestamp(layout, record);
+    uint64_t delta = (ts - prevTs) & mask; // handles the version 1 wrap
+    uint16_t result;
+    ft       flow;
+
+    if(delta > maxDeltaUs) maxDeltaUs = delta;
+    if(delta > gapUs)      gaps++;
+    prevTs = ts;
+
+    // checksum verification with the driver function
+    if(SF05_CheckCrc((u8t *)&record[layout->ofsData], 2,
+                     record[layout->ofsCrc]) != NO_ERROR)
+    {
+      crcErrors++;
+      continue;
+    }
+
+    result = Capture_GetResult(layout, record);
+    flow   = SF05_CalcFlow(result, offsetFlow, scaleFlow);
+
+    if(result < minResult) minResult = result;
+    if(result > maxResult) maxResult = result;
+    sumFlow += flow;
+
+    // trapezoidal integration between consecutive valid readings, not
+    // across gaps
+    if(!hasValid)
+    {
+      hasValid            = 1;
+      chunk->firstValidTs = ts;
+      chunk->firstFlow    = flow;
+    }
+    else if(((ts - prevValidTs) & mask) <= gapUs)
+    {
+      volume += 0.5 * ((double)flow + prevFlow) *
+                (double)((ts - prevValidTs) & mask);
+    }
+    prevValidTs = ts;
+    prevFlow    = flow;
+  }
+
+  chunk->crcErrors   = crcErrors;
+  chunk->gaps        = gaps;
+  chunk->maxDeltaUs  = maxDeltaUs;
+  chunk->minResult   = minResult;
+  chunk->maxResult   = maxResult;
+  chunk->sumFlow     = sumFlow;
+  chunk->volume      = volume;
+  chunk->lastTs      = prevTs;
+  chunk->hasValid    = hasValid;
+  chunk->lastValidTs = prevValidTs;
+  chunk->lastFlow    = prevFlow;
+  return NULL;
+}
+
+//==============================================================================
+static double ElapsedSeconds(const struct timespec *start){
+//==============================================================================
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)(now.tv_sec - start->tv_sec) +
+         (double)(now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+//==============================================================================
+static int AnalyzeFile(const char *path, unsigned nbrOfThreads){
+//==============================================================================
+  tChunk          chunks[MAX_THREADS];
+  pthread_t       threads[MAX_THREADS];
+  struct stat     st;
+  struct timespec start;
+  tCaptureLayout  layout;
+  const uint8_t  *map;
+  size_t          nbrOfRecords, perChunk, pos, dataSize;
+  uint64_t        crcErrors = 0, gaps = 0, valid;
+  uint64_t        maxDeltaUs = 0;
+  uint16_t        minResult = 0xFFFF, maxResult = 0x0000;
+  double          sumFlow = 0.0, volume = 0.0, seconds;
+  uint64_t        lastTs = 0, lastValidTs = 0;
+  ft              lastFlow = 0.0F;
+  int             hasValid = 0;
+  int             created[MAX_THREADS];
+  unsigned        i;
+  int             fd;
+
+  fd = open(path, O_RDONLY);
+  if(fd < 0 || fstat(fd, &st) != 0)
+  {
+    fprintf(stderr, "%s: %s\n", path, strerror(errno));
+    if(fd >= 0) close(fd);
+    return 1;
+  }
+
+  if(st.st_size == 0)
+  {
+    printf("%s: no records\n", path);
+    close(fd);
+    return 0;
+  }
+
+  map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(map == MAP_FAILED)
+  {
+    fprintf(stderr, "%s: mmap: %s\n", path, strerror(errno));
+    return 1;
+  }
+  // advice codes, not flags -> one call each
+  madvise((void *)map, (size_t)st.st_size, MADV_SEQUENTIAL);
+  madvise((void *)map, (size_t)st.st_size, MADV_WILLNEED);
+
+  // the records follow the header, if there is one
+  Capture_GetLayout(map, (size_t)st.st_size, &layout);
+  dataSize     = (size_t)st.st_size - layout.headerSize;
+  nbrOfRecords = dataSize / layout.recordSize;
+  if(dataSize % layout.recordSize != 0)
+    fprintf(stderr, "%s: ignoring %u trailing bytes\n", path,
+            (unsigned)(dataSize % layout.recordSize));
+  if(nbrOfRecords == 0)
+  {
+    printf("%s: no records\n", path);
+    munmap((void *)map, (size_t)st.st_size);
+    return 0;
+  }
+
+  // split into contiguous chunks of whole records, one per thread
+  if(nbrOfThreads > nbrOfRecords) nbrOfThreads = (unsigned)nbrOfRecords;
+  perChunk = nbrOfRecords / nbrOfThreads;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(i = 0, pos = 0; i < nbrOfThreads; i++)
+  {
+    memset(&chunks[i], 0, sizeof(chunks[i]));
+    chunks[i].layout       = &layout;
+    chunks[i].records      = map + layout.headerSize +
+                             pos * layout.recordSize;
+    chunks[i].nbrOfRecords = (i == nbrOfThreads - 1) ? nbrOfRecords - pos
+                                                      : perChunk;
+    pos += chunks[i].nbrOfRecords;
+    created[i] = (pthread_create(&threads[i], NULL, ProcessChunk,
+                                 &chunks[i]) == 0);
+    if(!created[i]) ProcessChunk(&chunks[i]); // fall back to this thread
+  }
+  for(i = 0; i < nbrOfThreads; i++)
+    if(created[i]) pthread_join(threads[i], NULL);
+  seconds = ElapsedSeconds(&start);
+
+  // merge partial results in file order, including the chunk boundaries
+  for(i = 0; i < nbrOfThreads; i++)
+  {
+    const tChunk *c = &chunks[i];
+
+    crcErrors += c->crcErrors;
+    gaps      += c->gaps;
+    sumFlow   += c->sumFlow;
+    volume    += c->volume;
+    if(c->maxDeltaUs > maxDeltaUs) maxDeltaUs = c->maxDeltaUs;
+    if(c->hasValid && c->minResult < minResult) minResult = c->minResult;
+    if(c->hasValid && c->maxResult > maxResult) maxResult = c->maxResult;
+
+    if(i > 0)
+    {
+      uint64_t delta = (c->firstTs - lastTs) & layout.tsMask;
+      if(delta > maxDeltaUs) maxDeltaUs = delta;
+      if(delta > gapUs)      gaps++;
+    }
+    if(c->hasValid)
+    {
+      uint64_t delta = (c->firstValidTs - lastValidTs) & layout.tsMask;
+
+      if(hasValid && delta <= gapUs)
+        volume += 0.5 * ((double)c->firstFlow + lastFlow) * (double)delta;
+      hasValid    = 1;
+      lastValidTs = c->lastValidTs;
+      lastFlow    = c->lastFlow;
+    }
+    lastTs = c->lastTs;
+  }
+  valid = nbrOfRecords - crcErrors;
+
+  printf("%s\n", path);
+  printf("  format         : version %u, %s\n", layout.version,
+         (layout.timeBase == CAPTURE_TIME_HOST) ?
+         "host time (CLOCK_MONOTONIC)" : "device ticks");
+  printf("  records        : %llu (%llu valid, %llu checksum errors)\n",
+         (unsigned long long)nbrOfRecords, (unsigned long long)valid,
+         (unsigned long long)crcErrors);
+  if(valid > 0)
+  {
+    printf("  flow min/max   : %.3f / %.3f\n",
+           SF05_CalcFlow(minResult, offsetFlow, scaleFlow),
+           SF05_CalcFlow(maxResult, offsetFlow, scaleFlow));
+    printf("  flow mean      : %.3f\n", sumFlow / (double)valid);
+    printf("  flow total     : %.3f (integrated, unit x min)\n",
+           volume / 60e6);
+  }
+  printf("  gaps           : %llu (> %luus, largest delta %lluus)\n",
+         (unsigned long long)gaps, (unsigned long)gapUs,
+         (unsigned long long)maxDeltaUs);
+  printf("  throughput     : %.1f MB/s on %u threads\n",
+         (double)st.st_size / 1e6 / (seconds > 0.0 ? seconds : 1e-9),
+         nbrOfThreads);
+
+  munmap((void *)map, (size_t)st.st_size);
+  return 0;
+}
+
+//==============================================================================
+static int Usage(const char *name){
+//==============================================================================
+  fprintf(stderr, "usage: %s [-j threads] [-o offset] [-s scale] "
+                  "[-g gap_us] file..\n", name);
+  return 2;
+}
+
+//==============================================================================
+int main(int argc, char *argv[]){
+//==============================================================================
+  long nbrOfThreads = sysconf(_SC_NPROCESSORS_ONLN);
+  int  opt, i, error = 0;
+
+  while((opt = getopt(argc, argv, "j:o:s:g:")) != -1)
+  {
+    switch(opt)
+    {
+      case 'j': nbrOfThreads = strtol(optarg, NULL, 0);            break;
+      case 'o': offsetFlow   = strtof(optarg, NULL);               break;
+      case 's': scaleFlow    = strtof(optarg, NULL);               break;
+      case 'g': gapUs        = (uint32_t)strtoul(optarg, NULL, 0); break;
+      default:  return Usage(argv[0]);
+    }
+  }
+  if(optind >= argc || scaleFlow == 0.0F) return Usage(argv[0]);
+  if(nbrOfThreads < 1)           nbrOfThreads = 1;
+  if(nbrOfThreads > MAX_THREADS) nbrOfThreads = MAX_THREADS;
+
+  for(i = optind; i < argc; i++)
+    error |= AnalyzeFile(argv[i], (unsigned)nbrOfThreads);
+
+  return error;
+}
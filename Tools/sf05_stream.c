@@ -0,0 +1,381 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  sf05_stream.c (V1.2)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  Host (Linux)
+// Compiler  :  gcc
+// Brief     :  Decoder for the binary sample stream of the firmware (frame
+//              layout see Source/stream.h). Frames are parsed in place in the
+//              receive buffer, the samples are written as capture records
+//              (see capture.h), which can be analyzed with sf05_analyze.
+//              With -s, the device clock is synchronized to the host clock
+//              (CLOCK_MONOTONIC, see clock_sync.h) and the timestamps are
+//              written on the host time line, otherwise the device ticks are
+//              written; the capture header records which. The statistics
+//              windows and the reset gaps of the device are printed. The
+//              frames are decoded with the firmware functions
+//              (stream_frame.c).
+//
+// Build:   gcc -O2 -ISource -ITools/host -o sf05_stream
+//              Tools/sf05_stream.c Tools/clock_sync.c Source/stream_frame.c
+//              Source/stats.c Source/sf05_calc.c -lm
+//
+// Usage:   sf05_stream [-o capture_file] [-s sync_interval_ms] device|file|-
+//==============================================================================
+
+//-- Includes ------------------------------------------------------------------
+#include "host.h"
+#include "sf05.h"
+#include "stream.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "capture.h"
+#include "clock_sync.h"
+
+//-- Defines -------------------------------------------------------------------
+#define RX_BUFFER_SIZE  65536  // receive buffer size
+#define SYNC_FAST_COUNT 16     // number of requests sent at the start ...
+#define SYNC_FAST_MS    50     // ... with this interval [ms]
+// largest sample count the 8-bit checksum length allows
+#define MAX_SAMPLES     ((255 - (STREAM_HEADER_SIZE - 2)) / STREAM_SAMPLE_SIZE)
+
+//-- Type definitions ----------------------------------------------------------
+// Decoder state and counters.
+typedef struct{
+  FILE      *out;          // capture output
+  int        useSync;      // map the timestamps with the clock synchronization
+  tClockSync sync;         // clock synchronization state
+  uint64_t   rxTime;       // host time of the last read [us]
+  int        hasSequence;  // at least one sample frame received
+  uint16_t   nextSequence; // expected sequence number
+  uint64_t   frames;       // valid frames
+  uint64_t   samples;      // decoded samples
+  uint64_t   crcErrors;    // frames with checksum mismatch
+  uint64_t   lostFrames;   // frames missing according to the sequence numbers
+  uint64_t   skippedBytes; // bytes skipped while searching for a frame
+  uint64_t   unsynced;     // samples dropped before the first clock estimate
+  uint64_t   syncFrames;   // sync responses
+  uint64_t   statsFrames;  // statistics windows
+  uint64_t   resetFrames;  // reset gaps
+}tDecoder;
+
+//-- Global Variables ----------------------------------------------------------
+static volatile sig_atomic_t stop = 0;
+
+//==============================================================================
+static void OnSignal(int sig){
+//==============================================================================
+  (void)sig;
+  stop = 1;
+}
+
+//==============================================================================
+static uint16_t GetU16(const uint8_t *data){
+//==============================================================================
+  return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+//==============================================================================
+static uint32_t GetU32(const uint8_t *data){
+//==============================================================================
+  return (uint32_t)data[0]         | ((uint32_t)data[1] << 8) |
+         ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+//==============================================================================
+static float GetFloat(const uint8_t *data){
+//==============================================================================
+  uint32_t bits = GetU32(data);
+  float    value;
+
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+//==============================================================================
+static uint64_t GetHostTime(void){
+//==============================================================================
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000u + (uint64_t)now.tv_nsec / 1000u;
+}
+
+//==============================================================================
+static void HandleSamples(tDecoder *dec, const uint8_t *frame){
+//==============================================================================
+  uint8_t        record[CAPTURE_RECORD_SIZE];
+  uint8_t        count    = frame[3];
+  uint16_t       sequence = GetU16(&frame[4]);
+  const uint8_t *sample   = &frame[STREAM_HEADER_SIZE];
+  uint8_t        i;
+
+  if(dec->hasSequence && sequence != dec->nextSequence)
+    dec->lostFrames += (uint16_t)(sequence - dec->nextSequence);
+  dec->hasSequence       = 1;
+  dec->nextSequence = (uint16_t)(sequence + 1);
+  dec->frames++;
+
+  for(i = 0; i < count; i++, sample += STREAM_SAMPLE_SIZE)
+  {
+    uint64_t ticks  = Stream_GetU64(sample);
+    uint16_t result = GetU16(&sample[8]);
+    uint64_t host   = ticks;
+    u8t      data[2];
+
+    if(dec->useSync && !ClockSync_ToHost(&dec->sync, ticks, &host))
+    {
+      dec->unsynced++;
+      continue;
+    }
+
+    // the firmware only sends results with a valid sensor checksum, so the
+    // checksum of the capture record is regenerated
+    data[0] = (u8t)(result >> 8);
+    data[1] = (u8t)(result);
+    Capture_SetRecord(record, host, result, SF05_CalcCrc(data, 2));
+    fwrite(record, sizeof(record), 1, dec->out);
+    dec->samples++;
+  }
+}
+
+//==============================================================================
+static void HandleStatistics(tDecoder *dec, const uint8_t *frame){
+//==============================================================================
+  uint64_t ticks = Stream_GetU64(&frame[3]);
+  uint64_t host  = ticks;
+
+  // the time is on the host time line, if it can be mapped
+  if(dec->useSync && !ClockSync_ToHost(&dec->sync, ticks, &host)) host = 0;
+
+  dec->statsFrames++;
+  fprintf(stderr, "statistics at %llu us: %lu samples, min %u, max %u, "
+                  "mean %.3f, std. dev. %.3f, %g-quantile %.2f (raw)\n",
+          (unsigned long long)host, (unsigned long)GetU32(&frame[11]),
+          GetU16(&frame[15]), GetU16(&frame[17]), GetFloat(&frame[19]),
+          sqrt(GetFloat(&frame[23])), GetFloat(&frame[27]),
+          GetFloat(&frame[31]));
+}
+
+//==============================================================================
+static void HandleResetGap(tDecoder *dec, const uint8_t *frame){
+//==============================================================================
+  uint64_t ticks = Stream_GetU64(&frame[3]);
+  uint64_t host  = ticks;
+
+  if(dec->useSync && !ClockSync_ToHost(&dec->sync, ticks, &host)) host = 0;
+
+  dec->resetFrames++;
+  fprintf(stderr, "sensor reset at %llu us: sample gap %lu us\n",
+          (unsigned long long)host, (unsigned long)GetU32(&frame[11]));
+}
+
+//==============================================================================
+static size_t ParseFrames(tDecoder *dec, const uint8_t *buf, size_t len){
+//==============================================================================
+  size_t pos = 0;
+
+  while(len - pos >= STREAM_HEADER_SIZE)
+  {
+    const uint8_t *frame = &buf[pos];
+    size_t         size;
+
+    // search for the sync bytes and a known frame type
+    if(frame[0] != STREAM_SYNC_1 || frame[1] != STREAM_SYNC_2)
+      size = 0;
+    else if(frame[2] == STREAM_TYPE_SAMPLES)
+      size = (frame[3] == 0 || frame[3] > MAX_SAMPLES) ? 0 :
+             STREAM_HEADER_SIZE + (size_t)frame[3] * STREAM_SAMPLE_SIZE + 1;
+    else if(frame[2] == STREAM_TYPE_SYNC_RESPONSE)
+      size = STREAM_SYNC_RESPONSE_SIZE;
+    else if(frame[2] == STREAM_TYPE_STATISTICS)
+      size = STREAM_STATISTICS_SIZE;
+    else if(frame[2] == STREAM_TYPE_RESET_GAP)
+      size = STREAM_RESET_GAP_SIZE;
+    else
+      size = 0;
+    if(size == 0)
+    {
+      dec->skippedBytes++;
+      pos++;
+      continue;
+    }
+
+    if(len - pos < size) break; // wait for the rest of the frame
+
+    // the frame is checked and decoded in place
+    if(SF05_CheckCrc((u8t *)&frame[2], (u8t)(size - 3), frame[size - 1])
+       != NO_ERROR)
+    {
+      dec->crcErrors++;
+      dec->skippedBytes++;
+      pos++;
+      continue;
+    }
+
+    if(frame[2] == STREAM_TYPE_SYNC_RESPONSE)
+    {
+      ClockSync_HandleResponse(&dec->sync, frame, dec->rxTime);
+      dec->syncFrames++;
+      pos += size;
+      continue;
+    }
+
+    if(frame[2] == STREAM_TYPE_STATISTICS)
+      HandleStatistics(dec, frame);
+    else if(frame[2] == STREAM_TYPE_RESET_GAP)
+      HandleResetGap(dec, frame);
+    else
+      HandleSamples(dec, frame);
+    pos += size;
+  }
+
+  return pos;
+}
+
+//==============================================================================
+static void SetupTty(int fd){
+//==============================================================================
+  struct termios tio;
+
+  if(!isatty(fd) || tcgetattr(fd, &tio) != 0) return;
+  cfmakeraw(&tio);
+  cfsetispeed(&tio, B115200);
+  cfsetospeed(&tio, B115200);
+  tio.c_cc[VMIN]  = 1;
+  tio.c_cc[VTIME] = 0;
+  tcsetattr(fd, TCSANOW, &tio);
+}
+
+//==============================================================================
+static int Usage(const char *name){
+//==============================================================================
+  fprintf(stderr, "usage: %s [-o capture_file] [-s sync_interval_ms] "
+                  "device|file|-\n", name);
+  return 2;
+}
+
+//==============================================================================
+int main(int argc, char *argv[]){
+//==============================================================================
+  static uint8_t   buf[RX_BUFFER_SIZE];
+  struct sigaction sa;
+  struct pollfd    pfd;
+  tDecoder         dec;
+  const char      *outPath = NULL;
+  uint8_t          request[STREAM_SYNC_REQUEST_SIZE];
+  uint8_t          header[CAPTURE_HEADER_SIZE];
+  uint64_t         nextSync = 0, now;
+  unsigned         syncIntervalMs = 0, nbrOfRequests = 0, intervalMs;
+  size_t           len = 0, used;
+  ssize_t          n;
+  int              fd, opt, timeout;
+
+  while((opt = getopt(argc, argv, "o:s:")) != -1)
+  {
+    if(opt == 'o')      outPath = optarg;
+    else if(opt == 's') syncIntervalMs = (unsigned)strtoul(optarg, NULL, 0);
+    else                return Usage(argv[0]);
+  }
+  if(optind != argc - 1) return Usage(argv[0]);
+
+  memset(&dec, 0, sizeof(dec));
+  ClockSync_Init(&dec.sync);
+  dec.useSync = (syncIntervalMs > 0);
+  dec.out = (outPath != NULL) ? fopen(outPath, "wb") : stdout;
+  if(dec.out == NULL)
+  {
+    fprintf(stderr, "%s: %s\n", outPath, strerror(errno));
+    return 1;
+  }
+  Capture_SetHeader(header, dec.useSync ? CAPTURE_TIME_HOST
+                                        : CAPTURE_TIME_DEVICE);
+  fwrite(header, sizeof(header), 1, dec.out);
+
+  // the sync requests are written to the device
+  fd = (strcmp(argv[optind], "-") == 0) ? STDIN_FILENO
+                                        : open(argv[optind], (dec.useSync ?
+                                               O_RDWR : O_RDONLY) | O_NOCTTY);
+  if(fd < 0)
+  {
+    fprintf(stderr, "%s: %s\n", argv[optind], strerror(errno));
+    return 1;
+  }
+  SetupTty(fd);
+
+  // stop on Ctrl-C, poll() and read() return with EINTR
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = OnSignal;
+  sigaction(SIGINT, &sa, NULL);
+  sigaction(SIGTERM, &sa, NULL);
+
+  pfd.fd     = fd;
+  pfd.events = POLLIN;
+
+  while(!stop)
+  {
+    // send a sync request when it is due, faster at the start
+    timeout = -1;
+    if(dec.useSync)
+    {
+      now = GetHostTime();
+      if(now >= nextSync)
+      {
+        ClockSync_BuildRequest(&dec.sync, request, GetHostTime());
+        if(write(fd, request, sizeof(request)) != (ssize_t)sizeof(request))
+          fprintf(stderr, "sync request: %s\n", strerror(errno));
+        intervalMs = (++nbrOfRequests < SYNC_FAST_COUNT) ? SYNC_FAST_MS
+                                                         : syncIntervalMs;
+        nextSync = now + (uint64_t)intervalMs * 1000u;
+      }
+      timeout = (int)((nextSync - now + 999u) / 1000u);
+    }
+
+    n = poll(&pfd, 1, timeout);
+    if(n < 0 && errno == EINTR) continue;
+    if(n < 0) break;
+    if(n == 0) continue;
+
+    n = read(fd, &buf[len], sizeof(buf) - len);
+    dec.rxTime = GetHostTime();
+    if(n < 0 && errno == EINTR) continue;
+    if(n <= 0) break;
+    len += (size_t)n;
+
+    // only the incomplete tail of the buffer is moved to the front
+    used = ParseFrames(&dec, buf, len);
+    memmove(buf, &buf[used], len - used);
+    len -= used;
+  }
+
+  fflush(dec.out);
+  fprintf(stderr, "frames %llu, samples %llu, checksum errors %llu, "
+                  "lost frames %llu, skipped bytes %llu\n",
+          (unsigned long long)dec.frames, (unsigned long long)dec.samples,
+          (unsigned long long)dec.crcErrors,
+          (unsigned long long)dec.lostFrames,
+          (unsigned long long)dec.skippedBytes);
+  if(dec.useSync)
+    fprintf(stderr, "sync responses %llu, drift %.2f ppm, min. delay %.1f us, "
+                    "%u of %u exchanges used, unsynced samples %llu\n",
+            (unsigned long long)dec.syncFrames, (dec.sync.rate - 1.0) * 1e6,
+            dec.sync.minDelay, dec.sync.used, dec.sync.nbrOfPoints,
+            (unsigned long long)dec.unsynced);
+
+  if(outPath != NULL) fclose(dec.out);
+  if(fd != STDIN_FILENO) close(fd);
+  return 0;
+}
@@ -0,0 +1,214 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  test_calib.c (V1.0)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  Host (Linux)
+// Compiler  :  gcc
+// Brief     :  Host test of the calibration profiles (calib.c). The integer
+//              conversion of the included profiles is compared with the exact
+//              linear model for all raw results, and the correction table
+//              interpolation with a synthetic table (rising and falling
+//              segments), at the table entries, the midpoints, the end point
+//              and in between. A timing loop compares the integer conversion
+//              with the float conversion (SF05_CalcFlow) on the host; the
+//              target figures are measured with BENCHMARK in main.c.
+//
+// Build:   gcc -O2 -ISource -ITools/host -o test_calib
+//              Tools/test_calib.c Source/calib.c Source/sf05_calc.c -lm
+//
+// Usage:   test_calib
+//==============================================================================
+
+//-- Includes ------------------------------------------------------------------
+#include "host.h"
+#include "calib.h"
+#include "sf05.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+//-- Defines -------------------------------------------------------------------
+#define LINEAR_TOL   0.8       // linear model: rounding + gain resolution
+#define CORR_TOL     0.5       // correction: rounding of the interpolation
+#define TIMING_LOOPS 10000000  // conversions per path in the timing loop
+
+//-- Global Variables ----------------------------------------------------------
+// Synthetic correction table: rising and falling segments, steps of different
+// size and sign, and an end point (for 0xFFFF) different from its neighbor.
+static const i16t testTable[CALIB_TABLE_SIZE] = {
+      0,   120,   250,   251,   -80,  -700, -1500, -1499,
+  -1499, -1000,   333,  2000,  2000,  1999,   500,     3,
+     -3,  -250,  -251,   -7, 32000,     0, -32000,   77,
+     78,    79,    40,     1,     0,   -64,  -999,  -500,
+   1234
+};
+
+//==============================================================================
+static double ExactLinear(const stCalibProfile *profile, double scale,
+                          u16t result){
+//==============================================================================
+  return ((double)result - profile->offset) * CALIB_FLOW_UNIT / scale;
+}
+
+//==============================================================================
+static double ExactCorrection(u16t result){
+//==============================================================================
+  u16t   i    = result >> CALIB_FRAC_BITS;
+  double frac = (double)(result & ((1 << CALIB_FRAC_BITS) - 1)) /
+                (1 << CALIB_FRAC_BITS);
+
+  return testTable[i] + frac * (testTable[i + 1] - testTable[i]);
+}
+
+//==============================================================================
+static int TestLinear(void){
+//==============================================================================
+  static const double scales[] = { 140.0, 142.8 }; // see calib.c
+  const stCalibProfile *profile;
+  double                err, maxErr;
+  u32t                  result;
+  u8t                   p;
+  int                   errors = 0;
+
+  for(p = 0; p < Calib_GetNbrOfProfiles(); p++)
+  {
+    profile = Calib_GetProfile(p);
+    maxErr  = 0.0;
+    for(result = 0; result <= 0xFFFF; result++)
+    {
+      err = fabs(Calib_ConvertFlow(profile, (u16t)result) -
+                 ExactLinear(profile, scales[p], (u16t)result));
+      if(err > maxErr) maxErr = err;
+    }
+    printf("  linear %-8s max. error %.3f/%d\n", profile->name, maxErr,
+           CALIB_FLOW_UNIT);
+    errors += (maxErr > LINEAR_TOL);
+  }
+
+  return errors;
+}
+
+//==============================================================================
+static int CheckCorrection(const stCalibProfile *withTable,
+                           const stCalibProfile *linear, u16t result,
+                           double expected, double tol, const char *what){
+//==============================================================================
+  i32t corr = Calib_ConvertFlow(withTable, result) -
+              Calib_ConvertFlow(linear, result);
+
+  if(fabs(corr - expected) > tol)
+  {
+    printf("  FAILED %s: result 0x%04X, correction %ld, expected %.2f\n",
+           what, result, (long)corr, expected);
+    return 1;
+  }
+  return 0;
+}
+
+//==============================================================================
+static int TestCorrection(void){
+//==============================================================================
+  const stCalibProfile *linear    = Calib_GetProfile(0);
+  stCalibProfile        withTable = *linear;
+  u32t                  result;
+  u16t                  i, mid;
+  int                   errors = 0;
+
+  withTable.correction = testTable;
+
+  // table entries exactly, midpoints within the rounding
+  for(i = 0; i < CALIB_TABLE_SIZE - 1; i++)
+  {
+    mid = (u16t)((i << CALIB_FRAC_BITS) + (1 << (CALIB_FRAC_BITS - 1)));
+    errors += CheckCorrection(&withTable, linear, i << CALIB_FRAC_BITS,
+                              testTable[i], 0.0, "entry");
+    errors += CheckCorrection(&withTable, linear, mid,
+                              (testTable[i] + testTable[i + 1]) / 2.0,
+                              CORR_TOL, "midpoint");
+  }
+
+  // the largest result interpolates towards the end point
+  errors += CheckCorrection(&withTable, linear, 0xFFFF,
+                            ExactCorrection(0xFFFF), CORR_TOL, "end point");
+
+  // all results, including the falling segments
+  for(result = 0; result <= 0xFFFF; result++)
+    if(CheckCorrection(&withTable, linear, (u16t)result,
+                       ExactCorrection((u16t)result), CORR_TOL, "all"))
+    {
+      errors++;
+      break;
+    }
+
+  printf("  correction table         %s\n", errors ? "FAILED" : "ok");
+  return errors;
+}
+
+//==============================================================================
+static int TestSelection(void){
+//==============================================================================
+  int errors = 0;
+
+  errors += (Calib_SelectProfile(Calib_GetNbrOfProfiles()) != PARAMETER_ERROR);
+  errors += (Calib_GetProfile(Calib_GetNbrOfProfiles()) != NULL);
+  errors += (Calib_SelectProfile(1) != NO_ERROR);
+  errors += (Calib_GetFlow(40000) !=
+             Calib_ConvertFlow(Calib_GetProfile(1), 40000));
+  errors += (Calib_SelectProfile(0) != NO_ERROR);
+  errors += (Calib_GetFlow(40000) !=
+             Calib_ConvertFlow(Calib_GetProfile(0), 40000));
+
+  printf("  profile selection        %s\n", errors ? "FAILED" : "ok");
+  return errors;
+}
+
+//==============================================================================
+static double ElapsedNs(const struct timespec *t0, const struct timespec *t1){
+//==============================================================================
+  return (t1->tv_sec - t0->tv_sec) * 1e9 + (t1->tv_nsec - t0->tv_nsec);
+}
+
+//==============================================================================
+static void Timing(void){
+//==============================================================================
+  const stCalibProfile *profile = Calib_GetProfile(0);
+  struct timespec       t0, t1, t2;
+  volatile i32t         sinkInt;
+  volatile ft           sinkFloat;
+  u32t                  i;
+
+  Calib_SelectProfile(0);
+
+  // the raw results are spread over the whole range
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  for(i = 0; i < TIMING_LOOPS; i++)
+    sinkInt = Calib_GetFlow((u16t)(i * 65u));
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  for(i = 0; i < TIMING_LOOPS; i++)
+    sinkFloat = SF05_CalcFlow((u16t)(i * 65u), (ft)profile->offset, 140.0F);
+  clock_gettime(CLOCK_MONOTONIC, &t2);
+  (void)sinkInt;
+  (void)sinkFloat;
+
+  printf("  conversion: integer %.2f ns, float %.2f ns (host)\n",
+         ElapsedNs(&t0, &t1) / TIMING_LOOPS,
+         ElapsedNs(&t1, &t2) / TIMING_LOOPS);
+}
+
+//==============================================================================
+int main(void){
+//==============================================================================
+  int errors = 0;
+
+  errors += TestLinear();
+  errors += TestCorrection();
+  errors += TestSelection();
+  Timing();
+
+  printf("test_calib: %s\n", errors ? "FAILED" : "PASSED");
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,170 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  test_clock_sync.c (V1.0)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  Host (Linux)
+// Compiler  :  gcc
+// Brief     :  Host test of the clock synchronization against a simulated
+//              device with a skewed clock. The serial line is simulated in
+//              virtual time: USB latencies with jitter, the byte times at
+//              115200 baud, sample frames delaying the response, lost
+//              responses and corrupted requests. The device side uses the
+//              firmware encoder (stream_frame.c), the host side clock_sync.c.
+//              The estimated drift and the mapping of device timestamps onto
+//              the host time line must stay within fixed bounds.
+//
+// Build:   gcc -O2 -ISource -ITools/host -o test_clock_sync
+//              Tools/test_clock_sync.c Tools/clock_sync.c
+//              Source/stream_frame.c Source/stats.c Source/sf05_calc.c -lm
+//
+// Usage:   test_clock_sync
+//==============================================================================
+
+//-- Includes ------------------------------------------------------------------
+#include "host.h"
+#include "stream.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "clock_sync.h"
+
+//-- Defines -------------------------------------------------------------------
+// transmission time of one byte (start bit, 8 data bits, stop bit) [us]
+#define BYTE_TIME     (10.0 * 1e6 / STREAM_BAUDRATE)
+#define FAST_COUNT    16       // requests at the start ...
+#define FAST_INTERVAL 50000.0  // ... with this interval [us]
+#define INTERVAL      1000000.0 // interval afterwards [us], sf05_stream -s 1000
+#define WARM_UP       64       // exchanges before the bounds are checked
+#define ISR_LATENCY   5.0      // max. interrupt latency on the device [us]
+
+//-- Type definitions ----------------------------------------------------------
+// Simulated setup.
+typedef struct{
+  const char *name;          // description
+  double      drift;         // device clock rate error (1e-6 = 1 ppm)
+  double      offset;        // device time at host time 0 [ticks]
+  double      latency;       // min. USB latency, both directions [us]
+  double      jitter;        // additional USB latency, uniform 0..jitter [us]
+  double      busy;          // probability that a sample frame is being sent
+  double      loss;          // probability that a response is lost
+  double      corrupt;       // probability that a request is corrupted
+  unsigned    exchanges;     // number of requests
+  double      maxOffsetErr;  // bound for the mapping error [us]
+  double      maxDriftErr;   // bound for the drift error [ppm]
+}tTestCase;
+
+//-- Global Variables ----------------------------------------------------------
+static const tTestCase testCases[] = {
+  // bounds: the asymmetry of the latencies is up to +-jitter/2 per exchange
+  { "+500 ppm, low jitter",      500e-6, 4.2e9,   50.0,  125.0, 0.2, 0.0,
+    0.0,  600,  40.0,  3.0 },
+  { "+500 ppm",                  500e-6, 4.2e9,  150.0, 1000.0, 0.2, 0.0,
+    0.0,  600, 500.0, 20.0 },
+  { "-1 %",                     -1e-2,   1.0e6,  150.0, 1000.0, 0.2, 0.0,
+    0.0,  600, 500.0, 20.0 },
+  { "lost responses, id wrap",   50e-6,  7.7e11, 150.0, 1000.0, 0.2, 0.1,
+    0.05, 2000, 500.0, 20.0 },
+};
+
+static u64t randomState = 0x2545F4914F6CDD1DULL;
+
+//==============================================================================
+static double Random(void){
+//==============================================================================
+  // xorshift64*, uniform in [0, 1)
+  randomState ^= randomState >> 12;
+  randomState ^= randomState << 25;
+  randomState ^= randomState >> 27;
+  return (double)((randomState * 0x2545F4914F6CDD1DULL) >> 11) /
+         9007199254740992.0;
+}
+
+//==============================================================================
+static u64t DeviceTicks(const tTestCase *tc, double host){
+//==============================================================================
+  return (u64t)(tc->offset + (1.0 + tc->drift) * host);
+}
+
+//==============================================================================
+static int RunTestCase(const tTestCase *tc){
+//==============================================================================
+  tClockSync sync;
+  u8t        request[STREAM_SYNC_REQUEST_SIZE];
+  u8t        response[STREAM_SYNC_RESPONSE_SIZE];
+  u8t        lastId = 0;           // device: id of the last response sent
+  u64t       lastT3 = 0;           // device: its transmission start
+  uint64_t   mapped;
+  double     now = 1e6;            // host time [us]
+  double     t2Time, txTime, rxTime, err, driftErr;
+  double     maxErr = 0.0, maxDriftErr = 0.0;
+  unsigned   i;
+
+  ClockSync_Init(&sync);
+
+  for(i = 0; i < tc->exchanges; i++)
+  {
+    now += (i < FAST_COUNT) ? FAST_INTERVAL : INTERVAL;
+
+    // host: request stamped with t1 right before the write
+    ClockSync_BuildRequest(&sync, request, (uint64_t)now);
+    if(Random() < tc->corrupt) request[5] ^= 0x01;
+
+    // device: t2 when the first byte is received, the response is sent when
+    // the whole request is received and the DMA is idle
+    t2Time = now + tc->latency + tc->jitter * Random() + BYTE_TIME;
+    txTime = t2Time + (STREAM_SYNC_REQUEST_SIZE - 1) * BYTE_TIME +
+             ISR_LATENCY * Random();
+    if(Random() < tc->busy) txTime += STREAM_FRAME_SIZE * BYTE_TIME * Random();
+    if(Stream_EncodeSyncResponse(response, request,
+                                 DeviceTicks(tc, t2Time +
+                                             ISR_LATENCY * Random()),
+                                 lastId, lastT3) != NO_ERROR)
+      continue;
+    lastId = response[3];
+    lastT3 = DeviceTicks(tc, txTime);
+
+    // host: t4 when the read of the complete response returns
+    rxTime = txTime + STREAM_SYNC_RESPONSE_SIZE * BYTE_TIME + tc->latency +
+             tc->jitter * Random();
+    if(Random() >= tc->loss)
+      ClockSync_HandleResponse(&sync, response, (uint64_t)rxTime);
+
+    if(i < WARM_UP) continue;
+
+    // mapping of the current device time onto the host time line
+    if(!ClockSync_ToHost(&sync, DeviceTicks(tc, rxTime), &mapped))
+    {
+      printf("  FAILED %s: no estimate after %u exchanges\n", tc->name, i);
+      return 1;
+    }
+    err      = fabs((double)mapped - rxTime);
+    driftErr = fabs((sync.rate - 1.0 - tc->drift) * 1e6);
+    if(err > maxErr)           maxErr      = err;
+    if(driftErr > maxDriftErr) maxDriftErr = driftErr;
+  }
+
+  printf("  %-24s max. error %6.1f us, drift error %5.2f ppm  %s\n",
+         tc->name, maxErr, maxDriftErr,
+         (maxErr > tc->maxOffsetErr || maxDriftErr > tc->maxDriftErr) ?
+         "FAILED" : "ok");
+
+  return (maxErr > tc->maxOffsetErr || maxDriftErr > tc->maxDriftErr);
+}
+
+//==============================================================================
+int main(void){
+//==============================================================================
+  int    errors = 0;
+  size_t i;
+
+  for(i = 0; i < sizeof(testCases) / sizeof(testCases[0]); i++)
+    errors += RunTestCase(&testCases[i]);
+
+  printf("test_clock_sync: %s\n", errors ? "FAILED" : "PASSED");
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,238 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  test_stats.c (V1.0)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  Host (Linux)
+// Compiler  :  gcc
+// Brief     :  Host test of the online statistics (stats.c). Several windows
+//              of synthetic raw results are fed to the module and compared
+//              with the exact min/max, mean, variance and quantile of the
+//              stored window. A timing loop reports the update cost on the
+//              host (a host figure only, the target has no FPU).
+//
+// Build:   gcc -O2 -ISource -ITools/host -o test_stats
+//              Tools/test_stats.c Source/stats.c -lm
+//
+// Usage:   test_stats
+//==============================================================================
+
+//-- Includes ------------------------------------------------------------------
+#include "host.h"
+#include "stats.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//-- Defines -------------------------------------------------------------------
+#define MEAN_TOL      2e-3     // mean: float resolution at 32768 is 2e-3
+#define VARIANCE_TOL  1e-5     // variance: relative
+#define QUANTILE_TOL  0.35     // quantile: relative to the std. deviation
+#define TIMING_LOOPS  10000000 // updates in the timing loop
+
+//-- Type definitions ----------------------------------------------------------
+// Signal shape of a test window.
+typedef enum{
+  SHAPE_NOISE,     // normal noise around a constant flow
+  SHAPE_SKEWED,    // exponentially distributed peaks above a constant
+  SHAPE_UNIFORM,   // uniform over a wide range
+  SHAPE_ALTERNATE, // alternating +-100 around a constant
+  SHAPE_JUMP       // first result far below all others (large shifted values)
+}etShape;
+
+// Test window.
+typedef struct{
+  const char *name;       // description
+  etShape     shape;      // signal shape
+  ft          p;          // estimated quantile
+  u32t        windowSize; // samples per window
+  u32t        windows;    // number of windows
+}tTestCase;
+
+//-- Global Variables ----------------------------------------------------------
+static const tTestCase testCases[] = {
+  // name                       shape            p      window            n
+  { "noise, 1 min windows",     SHAPE_NOISE,     0.95F, 600,              20 },
+  { "noise, median",            SHAPE_NOISE,     0.50F, 600,              20 },
+  { "skewed, 5th percentile",   SHAPE_SKEWED,    0.05F, 10007,            5  },
+  { "uniform, 99th percentile", SHAPE_UNIFORM,   0.99F, 100000,           3  },
+  { "alternating, max. window", SHAPE_ALTERNATE, 0.50F, STATS_MAX_WINDOW, 1  },
+  { "jump from 0, max. window", SHAPE_JUMP,      0.95F, STATS_MAX_WINDOW, 1  },
+};
+
+static u64t randomState = 0x9E3779B97F4A7C15ULL;
+static u16t window[STATS_MAX_WINDOW];
+
+//==============================================================================
+static double Random(void){
+//==============================================================================
+  // xorshift64*, uniform in (0, 1)
+  randomState ^= randomState >> 12;
+  randomState ^= randomState << 25;
+  randomState ^= randomState >> 27;
+  return ((randomState * 0x2545F4914F6CDD1DULL >> 11) + 0.5) /
+         9007199254740992.0;
+}
+
+//==============================================================================
+static double RandomNormal(void){
+//==============================================================================
+  return sqrt(-2.0 * log(Random())) * cos(6.283185307179586 * Random());
+}
+
+//==============================================================================
+static u16t Sample(etShape shape, u32t i){
+//==============================================================================
+  double x;
+
+  switch(shape)
+  {
+    case SHAPE_NOISE:     x = 32000.0 + 25.0 * RandomNormal();        break;
+    case SHAPE_SKEWED:    x = 32000.0 - 40.0 * log(Random());         break;
+    case SHAPE_UNIFORM:   x = 1000.0 + 60000.0 * Random();            break;
+    case SHAPE_ALTERNATE: x = (i & 1) ? 32100.0 : 31900.0;            break;
+    default:              x = (i == 0) ? 0.0 : 60000.0 + 5535.0 * Random();
+  }
+  return (u16t)(x + 0.5);
+}
+
+//==============================================================================
+static int CompareU16(const void *a, const void *b){
+//==============================================================================
+  return (int)*(const u16t *)a - (int)*(const u16t *)b;
+}
+
+//==============================================================================
+static int CheckWindow(const tTestCase *tc, const stStatistics *stats,
+                       u32t size, u32t w){
+//==============================================================================
+  double mean = 0.0, var = 0.0, pos, quantile, sigma;
+  double errMean, errVar, errQuant;
+  u32t   i;
+
+  for(i = 0; i < size; i++) mean += window[i];
+  mean /= size;
+  for(i = 0; i < size; i++) var += (window[i] - mean) * (window[i] - mean);
+  var /= (size - 1);
+  sigma = sqrt(var);
+
+  qsort(window, size, sizeof(window[0]), CompareU16);
+  pos      = tc->p * (size - 1);
+  i        = (u32t)pos;
+  quantile = window[i] + (pos - i) * (window[(i + 1 < size) ? i + 1 : i] -
+                                      window[i]);
+
+  errMean  = fabs(Stats_GetMean(stats) - mean);
+  errVar   = fabs(Stats_GetVariance(stats) - var) / var;
+  errQuant = fabs(Stats_GetQuantile(stats) - quantile) / sigma;
+
+  if(stats->min != window[0] || stats->max != window[size - 1] ||
+     errMean > MEAN_TOL || errVar > VARIANCE_TOL || errQuant > QUANTILE_TOL)
+  {
+    printf("  FAILED %s, window %u: mean %.4f/%.4f, variance %.4f/%.4f, "
+           "quantile %.2f/%.2f, min %u/%u, max %u/%u\n", tc->name,
+           (unsigned)w,
+           Stats_GetMean(stats), mean, Stats_GetVariance(stats), var,
+           Stats_GetQuantile(stats), quantile, stats->min, window[0],
+           stats->max, window[size - 1]);
+    return 1;
+  }
+  return 0;
+}
+
+//==============================================================================
+static int RunTestCase(const tTestCase *tc){
+//==============================================================================
+  stStatistics stats;
+  u32t         w, i;
+  int          errors = 0;
+
+  if(Stats_Init(&stats, tc->p, tc->windowSize) != NO_ERROR) return 1;
+
+  for(w = 0; w < tc->windows; w++)
+  {
+    for(i = 0; i < tc->windowSize; i++)
+    {
+      window[i] = Sample(tc->shape, i);
+
+      // the last sample of a window must complete it, no other one
+      if(Stats_Update(&stats, window[i]) != (i == tc->windowSize - 1))
+      {
+        printf("  FAILED %s: window complete at sample %u\n", tc->name,
+               (unsigned)i);
+        return 1;
+      }
+    }
+    errors += CheckWindow(tc, &stats, tc->windowSize, w);
+  }
+
+  printf("  %-28s %s\n", tc->name, errors ? "FAILED" : "ok");
+  return errors;
+}
+
+//==============================================================================
+static int TestParameters(void){
+//==============================================================================
+  stStatistics stats;
+  int          errors = 0;
+
+  errors += (Stats_Init(&stats, 0.5F, 0) != PARAMETER_ERROR);
+  errors += (Stats_Init(&stats, 0.5F, STATS_MAX_WINDOW + 1) !=
+             PARAMETER_ERROR);
+  errors += (Stats_Init(&stats, 1.5F, 600) != PARAMETER_ERROR);
+  errors += (Stats_Init(&stats, 0.5F, STATS_MAX_WINDOW) != NO_ERROR);
+
+  // empty and single sample window
+  errors += (Stats_GetMean(&stats) != 0.0F);
+  errors += (Stats_GetVariance(&stats) != 0.0F);
+  Stats_Update(&stats, 12345);
+  errors += (Stats_GetMean(&stats) != 12345.0F);
+  errors += (Stats_GetQuantile(&stats) != 12345.0F);
+  errors += (Stats_GetVariance(&stats) != 0.0F);
+
+  printf("  %-28s %s\n", "parameters", errors ? "FAILED" : "ok");
+  return errors;
+}
+
+//==============================================================================
+static void Timing(void){
+//==============================================================================
+  stStatistics    stats;
+  struct timespec t0, t1;
+  volatile ft     sink;
+  u32t            i;
+
+  Stats_Init(&stats, 0.95F, 600);
+  for(i = 0; i < 65536; i++) window[i] = Sample(SHAPE_NOISE, i);
+
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  for(i = 0; i < TIMING_LOOPS; i++)
+    Stats_Update(&stats, window[i & 0xFFFF]);
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  sink = Stats_GetQuantile(&stats);
+  (void)sink;
+
+  printf("  update: %.1f ns per sample (host)\n",
+         ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) /
+         TIMING_LOOPS);
+}
+
+//==============================================================================
+int main(void){
+//==============================================================================
+  int    errors = 0;
+  size_t i;
+
+  errors += TestParameters();
+  for(i = 0; i < sizeof(testCases) / sizeof(testCases[0]); i++)
+    errors += RunTestCase(&testCases[i]);
+  Timing();
+
+  printf("test_stats: %s\n", errors ? "FAILED" : "PASSED");
+  return errors ? 1 : 0;
+}
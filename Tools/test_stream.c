@@ -0,0 +1,360 @@
+//==============================================================================
+//    S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SF05 Sample Code (V1.1)
+// File      :  test_stream.c (V1.0)
+// Author    :  RFU
+// Date      :  19-Oct-2026
+// Controller:  Host (Linux)
+// Compiler  :  gcc
+// Brief     :  Loopback test of the sample stream over a pseudo terminal. The
+//              frames are encoded with the firmware encoder (stream_frame.c)
+//              and written to the master side of a pty in small pieces,
+//              together with garbage, a corrupted frame, a sequence jump, a
+//              statistics and a reset gap frame. sf05_stream decodes the slave
+//              side, its capture records, counters and printed statistics and
+//              reset gap are compared with the expected ones.
+//
+// Build:   gcc -O2 -ISource -ITools/host -o test_stream Tools/test_stream.c
+//              Source/stream_frame.c Source/stats.c Source/sf05_calc.c -lm
+//
+// Usage:   test_stream [path_to_sf05_stream]
+//==============================================================================
+
+// posix_openpt, grantpt, unlockpt and ptsname
+#define _GNU_SOURCE
+
+//-- Includes ------------------------------------------------------------------
+#include "host.h"
+#include "sf05.h"
+#include "stream.h"
+#include "stats.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "capture.h"
+
+//-- Defines -------------------------------------------------------------------
+#define CHUNK_SIZE     37      // bytes per write, splits frames and headers
+#define NBR_OF_FRAMES  6       // frames written (incl. the corrupted one)
+#define MAX_RECORDS    (NBR_OF_FRAMES * STREAM_SAMPLES_PER_FRAME)
+#define STATS_FRAME    1       // index of the frame followed by statistics
+#define RESET_FRAME    4       // index of the frame after a sensor reset
+#define RESET_GAP      123456  // reported gap [ticks]
+#define MAX_STREAM     (16 + NBR_OF_FRAMES * STREAM_FRAME_SIZE + \
+                        STREAM_STATISTICS_SIZE + STREAM_RESET_GAP_SIZE)
+
+//-- Type definitions ----------------------------------------------------------
+// Frame written to the pty.
+typedef struct{
+  u16t sequence; // sequence number
+  int  corrupt;  // payload corrupted, frame must be dropped
+}tTestFrame;
+
+//-- Global Variables ----------------------------------------------------------
+// Sequence 0, 1, (2 corrupted), 3, then a jump over 4..6 to 7 and 8.
+static const tTestFrame frames[NBR_OF_FRAMES] = {
+  { 0, 0 }, { 1, 0 }, { 2, 1 }, { 3, 0 }, { 7, 0 }, { 8, 0 }
+};
+
+// Garbage before the first frame, including sync bytes with an unknown frame
+// type and a samples header with an invalid count.
+static const uint8_t garbage[] = {
+  0x00, 0xA5, 0x13, 0xA5, 0x5A, 0x07, 0xFF, 0xA5, 0x5A, 0x01, 0x00, 0x42
+};
+
+// Statistics over the samples up to STATS_FRAME, sent after this frame.
+static stStatistics stats;
+
+//==============================================================================
+static u64t TestTimestamp(u16t sequence, u8t index){
+//==============================================================================
+  return 0x0000000312345678ULL + 100000ULL *
+         ((u64t)sequence * STREAM_SAMPLES_PER_FRAME + index);
+}
+
+//==============================================================================
+static u16t TestResult(u16t sequence, u8t index){
+//==============================================================================
+  return (u16t)(32000 + 7 * sequence - 3 * index);
+}
+
+//==============================================================================
+static size_t BuildStream(uint8_t *stream){
+//==============================================================================
+  size_t len = 0;
+  u8t    size;
+  int    f;
+  u8t    i;
+
+  memcpy(stream, garbage, sizeof(garbage));
+  len += sizeof(garbage);
+
+  Stats_Init(&stats, 0.9F, (STATS_FRAME + 1) * STREAM_SAMPLES_PER_FRAME);
+
+  for(f = 0; f < NBR_OF_FRAMES; f++)
+  {
+    for(i = 0; i < STREAM_SAMPLES_PER_FRAME; i++)
+    {
+      Stream_PutSample(&stream[len], i, TestTimestamp(frames[f].sequence, i),
+                       TestResult(frames[f].sequence, i));
+      if(f <= STATS_FRAME)
+        Stats_Update(&stats, TestResult(frames[f].sequence, i));
+    }
+    size = Stream_FinishSamples(&stream[len], STREAM_SAMPLES_PER_FRAME,
+                                frames[f].sequence);
+    if(frames[f].corrupt) stream[len + size / 2] ^= 0x10;
+    len += size;
+
+    if(f == RESET_FRAME)
+    {
+      Stream_EncodeResetGap(&stream[len], TestTimestamp(frames[f].sequence, 0),
+                            RESET_GAP);
+      len += STREAM_RESET_GAP_SIZE;
+    }
+    if(f == STATS_FRAME)
+    {
+      Stream_EncodeStatistics(&stream[len], TestTimestamp(frames[f].sequence,
+                              STREAM_SAMPLES_PER_FRAME - 1), &stats);
+      len += STREAM_STATISTICS_SIZE;
+    }
+  }
+
+  return len;
+}
+
+//==============================================================================
+static int OpenPty(int *slave){
+//==============================================================================
+  struct termios tio;
+  int            master;
+
+  master = posix_openpt(O_RDWR | O_NOCTTY);
+  if(master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) return -1;
+
+  // raw mode before the first byte is written, the line discipline must not
+  // translate or echo the binary data
+  *slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+  if(*slave < 0 || tcgetattr(*slave, &tio) != 0) return -1;
+  cfmakeraw(&tio);
+  if(tcsetattr(*slave, TCSANOW, &tio) != 0) return -1;
+
+  return master;
+}
+
+//==============================================================================
+static void SleepMs(long ms){
+//==============================================================================
+  struct timespec ts = { ms / 1000, (ms % 1000) * 1000000L };
+  nanosleep(&ts, NULL);
+}
+
+//==============================================================================
+static int CheckRecords(const char *path){
+//==============================================================================
+  uint8_t        header[CAPTURE_HEADER_SIZE];
+  uint8_t        records[MAX_RECORDS + 1][CAPTURE_RECORD_SIZE];
+  tCaptureLayout layout;
+  size_t         n, r = 0;
+  int            f, errors = 0;
+  u8t            i;
+  FILE          *in = fopen(path, "rb");
+
+  if(in == NULL)
+  {
+    fprintf(stderr, "%s: %s\n", path, strerror(errno));
+    return 1;
+  }
+  n = fread(header, sizeof(header), 1, in);
+  n = (n == 1) ? fread(records, CAPTURE_RECORD_SIZE, MAX_RECORDS + 1, in) : 0;
+  fclose(in);
+
+  // version 2 with the device ticks (no clock synchronization)
+  Capture_GetLayout(header, sizeof(header), &layout);
+  if(layout.version != CAPTURE_VERSION ||
+     layout.timeBase != CAPTURE_TIME_DEVICE)
+  {
+    fprintf(stderr, "capture header: version %u, time base %u\n",
+            layout.version, layout.timeBase);
+    errors++;
+  }
+
+  for(f = 0; f < NBR_OF_FRAMES; f++)
+  {
+    if(frames[f].corrupt) continue;
+    for(i = 0; i < STREAM_SAMPLES_PER_FRAME; i++, r++)
+    {
+      u16t seq = frames[f].sequence;
+      u8t  data[2];
+
+      if(r >= n) break;
+      data[0] = records[r][CAPTURE_OFS_DATA];
+      data[1] = records[r][CAPTURE_OFS_DATA + 1];
+      // the full 64-bit timestamp (above 2^32 us) is kept
+      if(Capture_GetTimestamp(&layout, records[r]) != TestTimestamp(seq, i) ||
+         Capture_GetResult(&layout, records[r]) != TestResult(seq, i) ||
+         SF05_CheckCrc(data, 2, records[r][CAPTURE_OFS_CRC]) != NO_ERROR)
+      {
+        fprintf(stderr, "record %zu (frame %u, sample %u) mismatch\n",
+                r, seq, i);
+        errors++;
+      }
+    }
+  }
+
+  if(n != r)
+  {
+    fprintf(stderr, "%zu records, expected %zu\n", n, r);
+    errors++;
+  }
+  return errors;
+}
+
+//==============================================================================
+static int CheckOutput(const char *output){
+//==============================================================================
+  const char        *line;
+  unsigned long long cnt[5], time;
+  unsigned long      count, gap;
+  unsigned           min, max;
+  double             mean, sigma, p, quantile;
+  int                errors = 0;
+
+  // 5 frames decoded (80 samples), 1 checksum error, 4 lost frames (2 and
+  // 4..6), all garbage and the corrupted frame skipped
+  line = strstr(output, "frames ");
+  if(line == NULL ||
+     sscanf(line, "frames %llu, samples %llu, checksum errors %llu, "
+                  "lost frames %llu, skipped bytes %llu",
+            &cnt[0], &cnt[1], &cnt[2], &cnt[3], &cnt[4]) != 5 ||
+     cnt[0] != NBR_OF_FRAMES - 1 ||
+     cnt[1] != (NBR_OF_FRAMES - 1) * STREAM_SAMPLES_PER_FRAME ||
+     cnt[2] != 1 || cnt[3] != 4 ||
+     cnt[4] != sizeof(garbage) + STREAM_FRAME_SIZE)
+  {
+    fprintf(stderr, "unexpected decoder counters\n");
+    errors++;
+  }
+
+  // the statistics as printed by the decoder
+  line = strstr(output, "statistics at ");
+  if(line == NULL ||
+     sscanf(line, "statistics at %llu us: %lu samples, min %u, max %u, "
+                  "mean %lf, std. dev. %lf, %lf-quantile %lf",
+            &time, &count, &min, &max, &mean, &sigma, &p, &quantile) != 8 ||
+     time != TestTimestamp(frames[STATS_FRAME].sequence,
+                           STREAM_SAMPLES_PER_FRAME - 1) ||
+     count != stats.count || min != stats.min || max != stats.max ||
+     fabs(mean - Stats_GetMean(&stats)) > 1e-3 ||
+     fabs(sigma - sqrt(Stats_GetVariance(&stats))) > 1e-3 ||
+     fabs(p - stats.p) > 1e-6 ||
+     fabs(quantile - Stats_GetQuantile(&stats)) > 1e-2)
+  {
+    fprintf(stderr, "unexpected statistics\n");
+    errors++;
+  }
+
+  line = strstr(output, "sensor reset at ");
+  if(line == NULL ||
+     sscanf(line, "sensor reset at %llu us: sample gap %lu",
+            &time, &gap) != 2 ||
+     time != TestTimestamp(frames[RESET_FRAME].sequence, 0) || gap != RESET_GAP)
+  {
+    fprintf(stderr, "unexpected reset gap\n");
+    errors++;
+  }
+
+  return errors;
+}
+
+//==============================================================================
+int main(int argc, char *argv[]){
+//==============================================================================
+  static uint8_t     stream[MAX_STREAM];
+  const char        *decoder = (argc > 1) ? argv[1] : "./sf05_stream";
+  char               outPath[] = "/tmp/test_stream_XXXXXX";
+  char               output[1024];
+  size_t             len, pos;
+  ssize_t            n;
+  pid_t              pid;
+  int                master, slave, out, errPipe[2], status, pending;
+  int                errors = 0;
+
+  len = BuildStream(stream);
+
+  master = OpenPty(&slave);
+  out    = mkstemp(outPath);
+  if(master < 0 || out < 0 || pipe(errPipe) != 0)
+  {
+    perror("setup");
+    return 1;
+  }
+  close(out);
+
+  pid = fork();
+  if(pid == 0)
+  {
+    dup2(errPipe[1], STDERR_FILENO);
+    close(errPipe[0]);
+    execl(decoder, decoder, "-o", outPath, ptsname(master), (char *)NULL);
+    perror(decoder);
+    _exit(127);
+  }
+  close(errPipe[1]);
+
+  // write the stream in pieces, which split frames and headers
+  for(pos = 0; pos < len; pos += CHUNK_SIZE)
+  {
+    if(write(master, &stream[pos], (len - pos < CHUNK_SIZE) ? len - pos
+                                                           : CHUNK_SIZE) < 0)
+    {
+      perror("write");
+      return 1;
+    }
+    SleepMs(2);
+  }
+
+  // wait until the decoder has read everything, then stop it
+  do
+  {
+    SleepMs(20);
+    if(ioctl(slave, FIONREAD, &pending) != 0) pending = 0;
+  } while(pending > 0);
+  SleepMs(100);
+  kill(pid, SIGTERM);
+  waitpid(pid, &status, 0);
+
+  for(len = 0; len < sizeof(output) - 1; len += (size_t)n)
+  {
+    n = read(errPipe[0], &output[len], sizeof(output) - 1 - len);
+    if(n <= 0) break;
+  }
+  output[len] = '\0';
+  fputs(output, stdout);
+
+  errors += CheckOutput(output);
+  if(!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+  {
+    fprintf(stderr, "decoder failed\n");
+    errors++;
+  }
+  errors += CheckRecords(outPath);
+
+  unlink(outPath);
+  close(slave);
+  close(master);
+
+  printf("test_stream: %s\n", errors ? "FAILED" : "PASSED");
+  return errors ? 1 : 0;
+}